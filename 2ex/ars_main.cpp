@@ -98,6 +98,7 @@ void work_with_vector()
             std::cout << signals[i] << " ";
         }
         std::cout << "\n";
+        delete[] signals;
     }
     catch (const std::exception &e)
     {
@@ -202,14 +203,13 @@ void index_access()
         Triple_signal::Triple_vector vec(vec_str);
         std::cout << "Вектор: " << vec << "\n";
         
-        int size;
-        vec.get_signals(size);
+        int size = vec.get_size();
         std::cout << "Размер: " << size << "\n";
         
         std::cout << "Введите индекс для доступа (0-" << size - 1 << "): ";
         int index = readint(std::cin, -1);
         
-        Triple_signal::Triple_signal &sig = vec[index];
+        Triple_signal::Triple_signal sig = vec[index];
         std::cout << "Элемент с индексом " << index << ": " << sig << "\n";
         
         std::cout << "Хотите изменить этот элемент? (1-Да, 0-Нет): ";
@@ -241,9 +241,6 @@ void slice_vector()
         Triple_signal::Triple_vector vec(vec_str);
         std::cout << "Вектор: " << vec << "\n";
         
-        int size;
-        vec.get_signals(size);
-        
         std::cout << "Введите начальный индекс: ";
         size_t start = readint(std::cin, -1);
         
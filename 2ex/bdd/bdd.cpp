@@ -0,0 +1,483 @@
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "bdd.hpp"
+
+namespace Triple_signal
+{
+    namespace
+    {
+        bool is_terminal(uint32_t node)
+        {
+            return node <= UNKNOWN;
+        }
+
+        void check_handle(const Bdd_manager *manager)
+        {
+            if (manager == nullptr)
+                throw std::logic_error("empty BDD");
+        }
+    }
+
+    Bdd::Bdd(Bdd_manager *manager, uint32_t node) : manager(manager), node(node)
+    {
+        manager->reference(node);
+    }
+
+    Bdd::Bdd(const Bdd &bdd) : manager(bdd.manager), node(bdd.node)
+    {
+        if (manager != nullptr)
+            manager->reference(node);
+    }
+
+    Bdd::Bdd(Bdd &&bdd) noexcept : manager(std::exchange(bdd.manager, nullptr)), node(bdd.node) {}
+
+    Bdd &Bdd::operator=(const Bdd &bdd)
+    {
+        if (bdd.manager != nullptr)
+            bdd.manager->reference(bdd.node);
+        if (manager != nullptr)
+            manager->dereference(node);
+
+        manager = bdd.manager;
+        node = bdd.node;
+        return *this;
+    }
+
+    Bdd &Bdd::operator=(Bdd &&bdd) noexcept
+    {
+        if (this != &bdd)
+        {
+            if (manager != nullptr)
+                manager->dereference(node);
+            manager = std::exchange(bdd.manager, nullptr);
+            node = bdd.node;
+        }
+        return *this;
+    }
+
+    Bdd::~Bdd()
+    {
+        if (manager != nullptr)
+            manager->dereference(node);
+    }
+
+    uint32_t Bdd::get_node() const
+    {
+        return node;
+    }
+
+    Bdd_manager *Bdd::get_manager() const
+    {
+        return manager;
+    }
+
+    bool Bdd::is_constant() const
+    {
+        check_handle(manager);
+        return is_terminal(node);
+    }
+
+    Triple_signal Bdd::get_constant() const
+    {
+        if (!is_constant())
+            throw std::logic_error("BDD is not a constant");
+        return Triple_signal(static_cast<Signal>(node));
+    }
+
+    Triple_signal Bdd::evaluate(const Triple_vector &inputs) const
+    {
+        check_handle(manager);
+        return manager->evaluate(*this, inputs);
+    }
+
+    size_t Bdd::get_size() const
+    {
+        check_handle(manager);
+        return manager->node_count(*this);
+    }
+
+    Bdd Bdd::operator&&(const Bdd &bdd) const
+    {
+        check_handle(manager);
+        return manager->apply_and(*this, bdd);
+    }
+
+    Bdd Bdd::operator||(const Bdd &bdd) const
+    {
+        check_handle(manager);
+        return manager->apply_or(*this, bdd);
+    }
+
+    Bdd Bdd::operator!() const
+    {
+        check_handle(manager);
+        return manager->apply_not(*this);
+    }
+
+    bool Bdd::operator==(const Bdd &bdd) const
+    {
+        return manager == bdd.manager && node == bdd.node;
+    }
+
+    bool Bdd::operator!=(const Bdd &bdd) const
+    {
+        return !(*this == bdd);
+    }
+
+    Bdd_manager::Bdd_manager(size_t cache_size, size_t gc_threshold)
+        : buckets(1024, no_node),
+          cache(std::bit_ceil(std::max<size_t>(cache_size, 1)), Cache_entry{NO_OPERATION, 0, 0, 0}),
+          gc_threshold(gc_threshold)
+    {
+        // Листья занимают узлы 0, 1, 2 - номера совпадают со значениями Signal
+        for (uint32_t leaf : {ZERO, ONE, UNKNOWN})
+            nodes.push_back(Node{terminal_variable, leaf, leaf, no_node, 0});
+    }
+
+    size_t Bdd_manager::hash_node(uint32_t variable, uint32_t low, uint32_t high)
+    {
+        uint64_t key = (uint64_t(variable) * 0x9E3779B97F4A7C15ull) ^ (uint64_t(low) << 32 | high);
+        key ^= key >> 29;
+        key *= 0xBF58476D1CE4E5B9ull;
+        return static_cast<size_t>(key ^ (key >> 32));
+    }
+
+    void Bdd_manager::insert_bucket(uint32_t node)
+    {
+        Node &entry = nodes[node];
+        size_t bucket = hash_node(entry.variable, entry.low, entry.high) & (buckets.size() - 1);
+        entry.next = buckets[bucket];
+        buckets[bucket] = node;
+    }
+
+    void Bdd_manager::grow_buckets()
+    {
+        buckets.assign(buckets.size() * 2, no_node);
+        for (uint32_t node = UNKNOWN + 1; node < nodes.size(); node++)
+        {
+            if (nodes[node].variable != free_variable)
+                insert_bucket(node);
+        }
+    }
+
+    uint32_t Bdd_manager::make_node(uint32_t variable, uint32_t low, uint32_t high)
+    {
+        if (low == high)
+            return low;
+
+        size_t bucket = hash_node(variable, low, high) & (buckets.size() - 1);
+        for (uint32_t node = buckets[bucket]; node != no_node; node = nodes[node].next)
+        {
+            const Node &entry = nodes[node];
+            if (entry.variable == variable && entry.low == low && entry.high == high)
+                return node;
+        }
+
+        uint32_t node;
+        if (free_list != no_node)
+        {
+            node = free_list;
+            free_list = nodes[node].next;
+            free_count--;
+            nodes[node] = Node{variable, low, high, no_node, 0};
+        }
+        else
+        {
+            if (nodes.size() >= free_variable)
+                throw std::length_error("BDD node pool exhausted");
+            node = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(Node{variable, low, high, no_node, 0});
+        }
+
+        insert_bucket(node);
+        if (nodes.size() - free_count > buckets.size())
+            grow_buckets();
+        return node;
+    }
+
+    void Bdd_manager::reference(uint32_t node)
+    {
+        nodes[node].references++;
+    }
+
+    void Bdd_manager::dereference(uint32_t node)
+    {
+        nodes[node].references--;
+    }
+
+    void Bdd_manager::maybe_collect()
+    {
+        // Сборка только на входе в операцию: промежуточные узлы рекурсии еще не защищены ссылками
+        if (nodes.size() - free_count >= gc_threshold)
+        {
+            collect_garbage();
+            gc_threshold = std::max(gc_threshold, 2 * (nodes.size() - free_count));
+        }
+    }
+
+    void Bdd_manager::check_owner(const Bdd &bdd) const
+    {
+        if (bdd.manager != this)
+            throw std::invalid_argument("BDD belongs to another manager");
+    }
+
+    uint32_t Bdd_manager::apply(Operation operation, uint32_t left, uint32_t right)
+    {
+        if (operation == AND_OPERATION)
+        {
+            if (left == ZERO || right == ZERO)
+                return ZERO;
+            if (left == ONE || left == right)
+                return right;
+            if (right == ONE)
+                return left;
+        }
+        else
+        {
+            if (left == ONE || right == ONE)
+                return ONE;
+            if (left == ZERO || left == right)
+                return right;
+            if (right == ZERO)
+                return left;
+        }
+
+        if (is_terminal(left) && is_terminal(right))
+        {
+            Triple_signal a(static_cast<Signal>(left)), b(static_cast<Signal>(right));
+            return (operation == AND_OPERATION ? a && b : a || b).get_signal();
+        }
+
+        // И и ИЛИ коммутативны: один порядок операндов - одна запись кэша
+        if (left > right)
+            std::swap(left, right);
+
+        Cache_entry &entry = cache[hash_node(operation, left, right) & (cache.size() - 1)];
+        if (entry.operation == operation && entry.left == left && entry.right == right)
+            return entry.result;
+
+        // Пул может перераспределиться при рекурсии, поэтому поля узлов копируются
+        uint32_t left_variable = nodes[left].variable;
+        uint32_t right_variable = nodes[right].variable;
+        uint32_t top = std::min(left_variable, right_variable);
+
+        uint32_t left_low = left_variable == top ? nodes[left].low : left;
+        uint32_t left_high = left_variable == top ? nodes[left].high : left;
+        uint32_t right_low = right_variable == top ? nodes[right].low : right;
+        uint32_t right_high = right_variable == top ? nodes[right].high : right;
+
+        uint32_t low = apply(operation, left_low, right_low);
+        uint32_t high = apply(operation, left_high, right_high);
+        uint32_t result = make_node(top, low, high);
+
+        cache[hash_node(operation, left, right) & (cache.size() - 1)] = Cache_entry{operation, left, right, result};
+        return result;
+    }
+
+    uint32_t Bdd_manager::negate(uint32_t node)
+    {
+        if (is_terminal(node))
+            return (!Triple_signal(static_cast<Signal>(node))).get_signal();
+
+        const Cache_entry &entry = cache[hash_node(NOT_OPERATION, node, 0) & (cache.size() - 1)];
+        if (entry.operation == NOT_OPERATION && entry.left == node)
+            return entry.result;
+
+        uint32_t variable = nodes[node].variable;
+        uint32_t node_low = nodes[node].low;
+        uint32_t node_high = nodes[node].high;
+
+        uint32_t low = negate(node_low);
+        uint32_t high = negate(node_high);
+        uint32_t result = make_node(variable, low, high);
+
+        cache[hash_node(NOT_OPERATION, node, 0) & (cache.size() - 1)] = Cache_entry{NOT_OPERATION, node, 0, result};
+        return result;
+    }
+
+    Bdd Bdd_manager::constant(const Triple_signal &signal)
+    {
+        return Bdd(this, signal.get_signal());
+    }
+
+    Bdd Bdd_manager::variable(uint32_t index)
+    {
+        if (index >= free_variable)
+            throw std::invalid_argument("variable index " + std::to_string(index) + " is reserved");
+
+        maybe_collect();
+        variable_count = std::max(variable_count, index + 1);
+        return Bdd(this, make_node(index, ZERO, ONE));
+    }
+
+    Bdd Bdd_manager::apply_and(const Bdd &left, const Bdd &right)
+    {
+        check_owner(left);
+        check_owner(right);
+        maybe_collect();
+        return Bdd(this, apply(AND_OPERATION, left.node, right.node));
+    }
+
+    Bdd Bdd_manager::apply_or(const Bdd &left, const Bdd &right)
+    {
+        check_owner(left);
+        check_owner(right);
+        maybe_collect();
+        return Bdd(this, apply(OR_OPERATION, left.node, right.node));
+    }
+
+    Bdd Bdd_manager::apply_not(const Bdd &operand)
+    {
+        check_owner(operand);
+        maybe_collect();
+        return Bdd(this, negate(operand.node));
+    }
+
+    Signal Bdd_manager::evaluate_node(uint32_t node, const Triple_vector &inputs)
+    {
+        if (is_terminal(node))
+            return static_cast<Signal>(node);
+        if (evaluation_stamps[node] == evaluation)
+            return evaluation_results[node];
+
+        uint32_t variable = nodes[node].variable;
+        if (variable >= inputs.get_size())
+        {
+            throw std::out_of_range("Variable " + std::to_string(variable) +
+                                    " out of range for " + std::to_string(inputs.get_size()) + " inputs");
+        }
+
+        Signal result;
+        switch (inputs[variable].get_signal())
+        {
+        case ZERO:
+            result = evaluate_node(nodes[node].low, inputs);
+            break;
+        case ONE:
+            result = evaluate_node(nodes[node].high, inputs);
+            break;
+        default:
+        {
+            Signal low = evaluate_node(nodes[node].low, inputs);
+            result = low == UNKNOWN || low != evaluate_node(nodes[node].high, inputs) ? UNKNOWN : low;
+            break;
+        }
+        }
+
+        evaluation_stamps[node] = evaluation;
+        evaluation_results[node] = result;
+        return result;
+    }
+
+    Triple_signal Bdd_manager::evaluate(const Bdd &bdd, const Triple_vector &inputs)
+    {
+        check_owner(bdd);
+
+        // Метки поколения вместо очистки памятки: каждое вычисление стоит O(размер диаграммы)
+        if (++evaluation == 0)
+        {
+            std::fill(evaluation_stamps.begin(), evaluation_stamps.end(), 0);
+            evaluation = 1;
+        }
+        evaluation_stamps.resize(nodes.size(), 0);
+        evaluation_results.resize(nodes.size(), UNKNOWN);
+
+        return Triple_signal(evaluate_node(bdd.node, inputs));
+    }
+
+    size_t Bdd_manager::node_count(const Bdd &bdd) const
+    {
+        check_owner(bdd);
+
+        std::vector<bool> visited(nodes.size(), false);
+        std::vector<uint32_t> stack{bdd.node};
+        visited[bdd.node] = true;
+        size_t count = 0;
+
+        while (!stack.empty())
+        {
+            uint32_t node = stack.back();
+            stack.pop_back();
+            count++;
+            if (is_terminal(node))
+                continue;
+
+            for (uint32_t child : {nodes[node].low, nodes[node].high})
+            {
+                if (!visited[child])
+                {
+                    visited[child] = true;
+                    stack.push_back(child);
+                }
+            }
+        }
+        return count;
+    }
+
+    size_t Bdd_manager::get_node_count() const
+    {
+        return nodes.size() - free_count;
+    }
+
+    uint32_t Bdd_manager::get_variable_count() const
+    {
+        return variable_count;
+    }
+
+    size_t Bdd_manager::collect_garbage()
+    {
+        std::vector<bool> marked(nodes.size(), false);
+        std::vector<uint32_t> stack;
+        for (uint32_t node = 0; node < nodes.size(); node++)
+        {
+            if (is_terminal(node) || (nodes[node].variable != free_variable && nodes[node].references != 0))
+            {
+                marked[node] = true;
+                stack.push_back(node);
+            }
+        }
+
+        while (!stack.empty())
+        {
+            uint32_t node = stack.back();
+            stack.pop_back();
+            if (is_terminal(node))
+                continue;
+
+            for (uint32_t child : {nodes[node].low, nodes[node].high})
+            {
+                if (!marked[child])
+                {
+                    marked[child] = true;
+                    stack.push_back(child);
+                }
+            }
+        }
+
+        size_t freed = 0;
+        std::fill(buckets.begin(), buckets.end(), no_node);
+        for (uint32_t node = UNKNOWN + 1; node < nodes.size(); node++)
+        {
+            if (nodes[node].variable == free_variable)
+                continue;
+
+            if (marked[node])
+                insert_bucket(node);
+            else
+            {
+                nodes[node].variable = free_variable;
+                nodes[node].next = free_list;
+                free_list = node;
+                free_count++;
+                freed++;
+            }
+        }
+
+        std::fill(cache.begin(), cache.end(), Cache_entry{NO_OPERATION, 0, 0, 0});
+        return freed;
+    }
+}
@@ -0,0 +1,335 @@
+/**
+ * @file bdd.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий троичные диаграммы решений (MTBDD) с листьями Triple_signal
+ * @version 0.1
+ * @date 2025-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef BDD_H
+#define BDD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../triple_signal/triple_signal.hpp"
+#include "../triple_vector/triple_vector.hpp"
+
+namespace Triple_signal
+{
+    class Bdd_manager;
+
+    /**
+     * @brief Функция, представленная упорядоченной сокращенной диаграммой решений
+     *
+     * Легкий дескриптор узла менеджера: копирование увеличивает внешний счетчик ссылок узла,
+     * поэтому узел и все достижимые из него переживают сборку мусора.
+     * Диаграммы канонические, поэтому равенство функций - сравнение номеров узлов за O(1).
+     * Менеджер должен жить дольше всех своих дескрипторов.
+     */
+    class Bdd
+    {
+        Bdd_manager *manager = nullptr;
+        uint32_t node = 0;
+
+        Bdd(Bdd_manager *manager, uint32_t node);
+
+        friend class Bdd_manager;
+
+    public:
+        /**
+         * @brief Конструктор по умолчанию
+         *
+         * Создает пустой дескриптор, не привязанный к менеджеру
+         *
+         */
+        Bdd() = default;
+
+        /**
+         * @brief Копирующий конструктор
+         *
+         */
+        Bdd(const Bdd &bdd);
+
+        /**
+         * @brief Перемещающий конструктор
+         *
+         */
+        Bdd(Bdd &&bdd) noexcept;
+
+        /**
+         * @brief Копирующий оператор присваивания
+         *
+         */
+        Bdd &operator=(const Bdd &bdd);
+
+        /**
+         * @brief Перемещающий оператор присваивания
+         *
+         */
+        Bdd &operator=(Bdd &&bdd) noexcept;
+
+        /**
+         * @brief Деструктор
+         *
+         * Снимает внешнюю ссылку, узел освобождается при следующей сборке мусора
+         */
+        ~Bdd();
+
+        /**
+         * @brief Номер корневого узла в менеджере
+         *
+         * @return uint32_t
+         */
+        uint32_t get_node() const;
+
+        /**
+         * @brief Менеджер, которому принадлежит диаграмма
+         *
+         * @return Bdd_manager*
+         */
+        Bdd_manager *get_manager() const;
+
+        /**
+         * @brief Является ли функция константой (листом)
+         *
+         */
+        bool is_constant() const;
+
+        /**
+         * @brief Значение константной функции
+         *
+         * @return Triple_signal
+         * @throw std::logic_error функция не константа
+         */
+        Triple_signal get_constant() const;
+
+        /**
+         * @brief Вычисление функции на наборе входов, в том числе неопределенных
+         *
+         * @see Bdd_manager::evaluate
+         */
+        Triple_signal evaluate(const Triple_vector &inputs) const;
+
+        /**
+         * @brief Количество узлов диаграммы, включая листья
+         *
+         * @return size_t
+         */
+        size_t get_size() const;
+
+        /**
+         * @brief Логическое И функций
+         *
+         * @throw std::invalid_argument функции из разных менеджеров
+         */
+        Bdd operator&&(const Bdd &bdd) const;
+
+        /**
+         * @brief Логическое ИЛИ функций
+         *
+         * @throw std::invalid_argument функции из разных менеджеров
+         */
+        Bdd operator||(const Bdd &bdd) const;
+
+        /**
+         * @brief Логическое НЕ функции
+         *
+         */
+        Bdd operator!() const;
+
+        /**
+         * @brief Эквивалентность функций
+         *
+         * @return true Функции совпадают на всех наборах входов
+         * @return false Функции различаются или принадлежат разным менеджерам
+         */
+        bool operator==(const Bdd &bdd) const;
+
+        /**
+         * @brief Неэквивалентность функций
+         *
+         */
+        bool operator!=(const Bdd &bdd) const;
+    };
+
+    /**
+     * @brief Менеджер троичных диаграмм решений (MTBDD)
+     *
+     * Внутренние узлы ветвятся по двоичным переменным в порядке их номеров,
+     * листья - три значения Triple_signal (0, 1, X). Операции И/ИЛИ/НЕ те же,
+     * что у Triple_signal: на листьях применяются операторы &&, ||, !,
+     * поэтому функции строятся из тех же формул, что и при симуляции.
+     *
+     * Узлы хранятся в пуле и делятся через таблицу уникальности (hash-consing),
+     * результаты операций запоминаются в кэше вычислений с прямым отображением.
+     * Узлы без внешних ссылок освобождаются сборкой мусора (пометка от дескрипторов Bdd),
+     * которая запускается автоматически перед операцией, когда пул вырос вдвое с прошлой сборки.
+     *
+     * Не потокобезопасен.
+     */
+    class Bdd_manager
+    {
+    public:
+        /**
+         * @brief Номер переменной листьев (больше номера любой переменной)
+         *
+         */
+        static constexpr uint32_t terminal_variable = UINT32_MAX;
+
+    private:
+        struct Node
+        {
+            uint32_t variable;
+            uint32_t low;
+            uint32_t high;
+            uint32_t next;
+            uint32_t references;
+        };
+
+        struct Cache_entry
+        {
+            uint32_t operation;
+            uint32_t left;
+            uint32_t right;
+            uint32_t result;
+        };
+
+        enum Operation : uint32_t
+        {
+            NO_OPERATION,
+            AND_OPERATION,
+            OR_OPERATION,
+            NOT_OPERATION
+        };
+
+        static constexpr uint32_t no_node = UINT32_MAX;
+        static constexpr uint32_t free_variable = UINT32_MAX - 1;
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> buckets;
+        std::vector<Cache_entry> cache;
+        uint32_t free_list = no_node;
+        size_t free_count = 0;
+        size_t gc_threshold;
+        uint32_t variable_count = 0;
+
+        std::vector<uint32_t> evaluation_stamps;
+        std::vector<Signal> evaluation_results;
+        uint32_t evaluation = 0;
+
+        static size_t hash_node(uint32_t variable, uint32_t low, uint32_t high);
+
+        uint32_t make_node(uint32_t variable, uint32_t low, uint32_t high);
+        void insert_bucket(uint32_t node);
+        void grow_buckets();
+        void reference(uint32_t node);
+        void dereference(uint32_t node);
+        void maybe_collect();
+        void check_owner(const Bdd &bdd) const;
+
+        uint32_t apply(Operation operation, uint32_t left, uint32_t right);
+        uint32_t negate(uint32_t node);
+        Signal evaluate_node(uint32_t node, const Triple_vector &inputs);
+
+        friend class Bdd;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * @param cache_size Число записей кэша вычислений (округляется вверх до степени двойки)
+         * @param gc_threshold Число узлов в пуле, после которого запускается первая сборка мусора
+         */
+        explicit Bdd_manager(size_t cache_size = 1 << 16, size_t gc_threshold = 1 << 16);
+
+        Bdd_manager(const Bdd_manager &) = delete;
+        Bdd_manager &operator=(const Bdd_manager &) = delete;
+
+        /**
+         * @brief Константная функция
+         *
+         * @param signal Значение
+         * @return Bdd Лист
+         */
+        Bdd constant(const Triple_signal &signal);
+
+        /**
+         * @brief Функция, равная переменной: 0 при переменной 0, 1 при переменной 1
+         *
+         * @param index Номер переменной, меньшие номера ближе к корню
+         * @return Bdd
+         * @throw std::invalid_argument номер переменной не меньше free_variable
+         */
+        Bdd variable(uint32_t index);
+
+        /**
+         * @brief Логическое И функций
+         *
+         * @throw std::invalid_argument функции из другого менеджера
+         */
+        Bdd apply_and(const Bdd &left, const Bdd &right);
+
+        /**
+         * @brief Логическое ИЛИ функций
+         *
+         * @throw std::invalid_argument функции из другого менеджера
+         */
+        Bdd apply_or(const Bdd &left, const Bdd &right);
+
+        /**
+         * @brief Логическое НЕ функции
+         *
+         * @throw std::invalid_argument функция из другого менеджера
+         */
+        Bdd apply_not(const Bdd &operand);
+
+        /**
+         * @brief Вычисление функции на наборе входов, в том числе неопределенных
+         *
+         * Неопределенная переменная рассматривается в обоих значениях: результат определен,
+         * если обе ветви дают одно и то же значение. Это точная троичная семантика,
+         * она не теряет определенность на переходах вида a || !a, в отличие от поэлементной симуляции.
+         * Каждый узел вычисляется не более одного раза: O(размер диаграммы).
+         *
+         * @param bdd Функция
+         * @param inputs Значение переменной i - сигнал i
+         * @return Triple_signal
+         * @throw std::out_of_range в функции есть переменная с номером не меньше inputs.get_size()
+         */
+        Triple_signal evaluate(const Bdd &bdd, const Triple_vector &inputs);
+
+        /**
+         * @brief Количество узлов, достижимых из функции, включая листья
+         *
+         * @return size_t
+         */
+        size_t node_count(const Bdd &bdd) const;
+
+        /**
+         * @brief Количество занятых узлов пула, включая листья и еще не собранные
+         *
+         * @return size_t
+         */
+        size_t get_node_count() const;
+
+        /**
+         * @brief Количество переменных (наибольший номер переменной + 1)
+         *
+         * @return uint32_t
+         */
+        uint32_t get_variable_count() const;
+
+        /**
+         * @brief Освобождает узлы, недостижимые из дескрипторов Bdd, и очищает кэш вычислений
+         *
+         * @return size_t Число освобожденных узлов
+         */
+        size_t collect_garbage();
+    };
+}
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file atomic_bench.cpp
+ * @author Alexey Parfenov
+ * @brief Замер масштабирования записи в Triple_atomic_vector по числу потоков и задержки снимков под записью
+ * @version 0.1
+ * @date 2025-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Запуск: atomic_bench [число сигналов] [максимум потоков]
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../triple_vector/triple_atomic_vector.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Каждый поток разрешает через ИЛИ свои сигналы (с шагом threads) в течение duration
+    double writes_per_us(Triple_signal::Triple_atomic_vector &bus, size_t threads, std::chrono::milliseconds duration,
+                         std::atomic<size_t> *snapshots)
+    {
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> writes{0};
+        std::vector<std::thread> writers;
+        for (size_t thread = 0; thread < threads; thread++)
+        {
+            writers.emplace_back([&, thread]()
+                                 {
+                size_t done = 0;
+                for (size_t index = thread; !stop; index += threads, done++)
+                {
+                    if (index >= bus.get_size())
+                        index = thread;
+                    bus.resolve_or(index, Triple_signal::Triple_signal('1'));
+                }
+                writes += done; });
+        }
+
+        // Читатель снимает шину, пока идет запись
+        std::thread reader;
+        if (snapshots)
+        {
+            reader = std::thread([&]()
+                                 {
+                while (!stop)
+                {
+                    bus.snapshot();
+                    (*snapshots)++;
+                } });
+        }
+
+        std::this_thread::sleep_for(duration);
+        stop = true;
+        for (std::thread &writer : writers)
+            writer.join();
+        if (reader.joinable())
+            reader.join();
+        return writes / (std::chrono::duration<double, std::micro>(duration).count());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 16;
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+    const std::chrono::milliseconds duration(300);
+
+    Triple_signal::Triple_atomic_vector bus(size);
+
+    std::cout << "signals: " << size << "\n";
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "writes/us" << std::setw(10) << "speedup"
+              << std::setw(22) << "writes/us + reader" << std::setw(14) << "snapshots/s" << "\n";
+
+    double baseline = 0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        double writes = writes_per_us(bus, threads, duration, nullptr);
+        std::atomic<size_t> snapshots{0};
+        double writes_read = writes_per_us(bus, threads, duration, &snapshots);
+        if (threads == 1)
+            baseline = writes;
+
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(16) << writes << std::setw(10) << writes / baseline
+                  << std::setw(22) << writes_read
+                  << std::setw(14) << snapshots / std::chrono::duration<double>(duration).count() << "\n";
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file parallel_bench.cpp
+ * @author Alexey Parfenov
+ * @brief Замер масштабирования операций над широкими векторами по числу потоков
+ * @version 0.1
+ * @date 2025-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Запуск: parallel_bench [число сигналов] [максимум потоков]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "../triple_vector/triple_vector.hpp"
+#include "../triple_vector/triple_parallel.hpp"
+
+namespace
+{
+    std::string random_signals(size_t size, unsigned seed)
+    {
+        std::mt19937_64 generator(seed);
+        std::string signals(size, 'X');
+        for (char &signal : signals)
+            signal = "01X"[generator() % 3];
+        return signals;
+    }
+
+    template <typename F>
+    double measure_ms(F &&function)
+    {
+        double best = 1e300;
+        for (int repeat = 0; repeat < 5; repeat++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            auto finish = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(finish - start).count());
+        }
+        return best;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    namespace parallel = Triple_signal::parallel;
+
+    size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+
+    Triple_signal::Triple_vector left(random_signals(size, 1));
+    Triple_signal::Triple_vector right(random_signals(size, 2));
+    // Копия разделила бы буфер с right, и == вернулся бы на сравнении указателей без memcmp
+    Triple_signal::Triple_vector right_copy(random_signals(size, 2));
+    Triple_signal::Triple_vector result;
+
+    std::cout << "signals: " << size << "\n";
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "and, ms" << std::setw(12) << "or, ms"
+              << std::setw(12) << "~(a&b), ms" << std::setw(12) << "concat, ms" << std::setw(12) << "==, ms"
+              << std::setw(10) << "speedup" << "\n";
+
+    double baseline = 0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        parallel::set_threads(threads);
+
+        double and_ms = measure_ms([&]
+                                   { result = left & right; });
+        double or_ms = measure_ms([&]
+                                  { result = left | right; });
+        double fused_ms = measure_ms([&]
+                                     { result = ~(left & right); });
+        double concat_ms = measure_ms([&]
+                                      { result = left + right; });
+        bool equal = false;
+        double compare_ms = measure_ms([&]
+                                       { equal = right == right_copy; });
+
+        if (threads == 1)
+            baseline = and_ms;
+
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(12) << and_ms << std::setw(12) << or_ms << std::setw(12) << fused_ms
+                  << std::setw(12) << concat_ms << std::setw(12) << compare_ms
+                  << std::setw(9) << baseline / and_ms << "x" << (equal ? "" : " (compare failed)") << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,442 @@
+/**
+ * @file triple_bench.cpp
+ * @author Alexey Parfenov
+ * @brief Микробенчмарки горячих путей Triple_vector
+ * @version 0.1
+ * @date 2025-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Каждый замер повторяется, пока не наберется --min_time секунд, и выводится
+ * в стиле Google Benchmark: время итерации, число итераций, нс на сигнал
+ * и байт кучи, выделенных за итерацию, на сигнал.
+ *
+ * Запуск: triple_bench [--filter=подстрока] [--max_size=N] [--min_time=секунды]
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../triple_vector/triple_vector.hpp"
+#include "../triple_vector/triple_arena.hpp"
+
+namespace
+{
+    std::atomic<size_t> allocated_bytes{0};
+    std::atomic<size_t> allocation_count{0};
+
+    void *counted_allocate(size_t bytes, size_t alignment)
+    {
+        allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+        void *memory = alignment <= alignof(std::max_align_t)
+                           ? std::malloc(bytes ? bytes : 1)
+                           : std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment);
+        if (!memory)
+            throw std::bad_alloc();
+        return memory;
+    }
+}
+
+// Подсчет выделений кучи внутри замеров: определения заменяют глобальные операторы только в этой программе
+void *operator new(size_t bytes)
+{
+    return counted_allocate(bytes, 0);
+}
+
+void *operator new[](size_t bytes)
+{
+    return counted_allocate(bytes, 0);
+}
+
+void *operator new(size_t bytes, std::align_val_t alignment)
+{
+    return counted_allocate(bytes, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t bytes, std::align_val_t alignment)
+{
+    return counted_allocate(bytes, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    /**
+     * @brief Запрещает компилятору выбросить вычисление value
+     *
+     */
+    template <typename T>
+    void do_not_optimize(const T &value)
+    {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    /**
+     * @brief Состояние одного замера
+     *
+     * Использование: while (state.keep_running()) { ... }, подготовка данных - до цикла
+     */
+    class Bench_state
+    {
+        size_t size;
+        double min_time;
+        size_t iterations = 0;
+        size_t bytes_at_start = 0;
+        size_t allocations_at_start = 0;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point finish;
+
+    public:
+        double elapsed = 0;
+        size_t bytes = 0;
+        size_t allocations = 0;
+
+        Bench_state(size_t size, double min_time) : size(size), min_time(min_time) {}
+
+        size_t get_size() const
+        {
+            return size;
+        }
+
+        size_t get_iterations() const
+        {
+            return iterations;
+        }
+
+        bool keep_running()
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (iterations == 0)
+            {
+                bytes_at_start = allocated_bytes;
+                allocations_at_start = allocation_count;
+                start = now;
+            }
+            else if (std::chrono::duration<double>(now - start).count() >= min_time)
+            {
+                finish = now;
+                elapsed = std::chrono::duration<double>(finish - start).count();
+                bytes = allocated_bytes - bytes_at_start;
+                allocations = allocation_count - allocations_at_start;
+                return false;
+            }
+            iterations++;
+            return true;
+        }
+    };
+
+    std::string random_signals(size_t size, unsigned seed)
+    {
+        std::mt19937_64 generator(seed);
+        std::string signals(size, 'X');
+        for (size_t i = 0; i < size; i += 32)
+        {
+            uint64_t bits = generator();
+            for (size_t j = i; j < std::min(size, i + 32); j++, bits >>= 2)
+                signals[j] = "01X1"[bits & 3];
+        }
+        return signals;
+    }
+
+    struct Benchmark
+    {
+        const char *name;
+        std::function<void(Bench_state &)> body;
+    };
+
+    std::vector<Benchmark> benchmarks()
+    {
+        using Triple_signal::Triple_vector;
+
+        return {
+            {"construct_from_string", [](Bench_state &state)
+             {
+                 std::string signals = random_signals(state.get_size(), 1);
+                 while (state.keep_running())
+                 {
+                     Triple_vector vector(signals);
+                     do_not_optimize(vector);
+                 }
+             }},
+            {"and", [](Bench_state &state)
+             {
+                 Triple_vector left(random_signals(state.get_size(), 1));
+                 Triple_vector right(random_signals(state.get_size(), 2));
+                 Triple_vector result;
+                 while (state.keep_running())
+                 {
+                     result = left & right;
+                     do_not_optimize(result);
+                 }
+             }},
+            {"or", [](Bench_state &state)
+             {
+                 Triple_vector left(random_signals(state.get_size(), 1));
+                 Triple_vector right(random_signals(state.get_size(), 2));
+                 Triple_vector result;
+                 while (state.keep_running())
+                 {
+                     result = left | right;
+                     do_not_optimize(result);
+                 }
+             }},
+            {"not", [](Bench_state &state)
+             {
+                 Triple_vector operand(random_signals(state.get_size(), 1));
+                 Triple_vector result;
+                 while (state.keep_running())
+                 {
+                     result = ~operand;
+                     do_not_optimize(result);
+                 }
+             }},
+            {"fused_not_and_or", [](Bench_state &state)
+             {
+                 Triple_vector a(random_signals(state.get_size(), 1));
+                 Triple_vector b(random_signals(state.get_size(), 2));
+                 Triple_vector c(random_signals(state.get_size(), 3));
+                 Triple_vector result;
+                 while (state.keep_running())
+                 {
+                     result = ~(a & b) | c;
+                     do_not_optimize(result);
+                 }
+             }},
+            {"slice_view", [](Bench_state &state)
+             {
+                 Triple_vector vector(random_signals(state.get_size(), 1));
+                 while (state.keep_running())
+                 {
+                     Triple_signal::Triple_vector_view view = vector[{1, state.get_size() - 1}];
+                     do_not_optimize(view);
+                 }
+             }},
+            {"slice_copy", [](Bench_state &state)
+             {
+                 Triple_vector vector(random_signals(state.get_size(), 1));
+                 while (state.keep_running())
+                 {
+                     Triple_vector slice(vector[{1, state.get_size() - 1}]);
+                     do_not_optimize(slice);
+                 }
+             }},
+            {"concat", [](Bench_state &state)
+             {
+                 Triple_vector left(random_signals(state.get_size() / 2, 1));
+                 Triple_vector right(random_signals(state.get_size() - state.get_size() / 2, 2));
+                 Triple_vector result;
+                 while (state.keep_running())
+                 {
+                     result = left + right;
+                     do_not_optimize(result);
+                 }
+             }},
+            {"push_back", [](Bench_state &state)
+             {
+                 Triple_signal::Triple_signal signal('1');
+                 while (state.keep_running())
+                 {
+                     Triple_vector vector;
+                     for (size_t i = 0; i < state.get_size(); i++)
+                         vector.push_back(signal);
+                     do_not_optimize(vector);
+                 }
+             }},
+            {"compare_equal", [](Bench_state &state)
+             {
+                 std::string signals = random_signals(state.get_size(), 1);
+                 Triple_vector left(signals);
+                 Triple_vector right(signals);
+                 while (state.keep_running())
+                 {
+                     bool equal = left == right;
+                     do_not_optimize(equal);
+                 }
+             }},
+            {"stream_out", [](Bench_state &state)
+             {
+                 Triple_vector vector(random_signals(state.get_size(), 1));
+                 std::ostringstream out;
+                 while (state.keep_running())
+                 {
+                     out.seekp(0);
+                     out << vector;
+                     do_not_optimize(out);
+                 }
+             }},
+            {"stream_in", [](Bench_state &state)
+             {
+                 std::istringstream in(random_signals(state.get_size(), 1));
+                 Triple_vector vector;
+                 while (state.keep_running())
+                 {
+                     in.clear();
+                     in.seekg(0);
+                     in >> vector;
+                     do_not_optimize(vector);
+                 }
+             }},
+            {"to_chars", [](Bench_state &state)
+             {
+                 Triple_vector vector(random_signals(state.get_size(), 1));
+                 std::string buffer(state.get_size(), ' ');
+                 while (state.keep_running())
+                 {
+                     auto result = to_chars(buffer.data(), buffer.data() + buffer.size(), vector);
+                     do_not_optimize(result);
+                 }
+             }},
+            {"from_chars", [](Bench_state &state)
+             {
+                 std::string signals = random_signals(state.get_size(), 1);
+                 Triple_vector vector;
+                 while (state.keep_running())
+                 {
+                     auto result = from_chars(signals.data(), signals.data() + signals.size(), vector);
+                     do_not_optimize(result);
+                 }
+             }},
+            {"cycle_temporaries", [](Bench_state &state)
+             {
+                 Triple_vector a(random_signals(state.get_size(), 1));
+                 Triple_vector b(random_signals(state.get_size(), 2));
+                 Triple_vector register_state(random_signals(state.get_size(), 3));
+                 while (state.keep_running())
+                 {
+                     Triple_vector sum(a & b);
+                     Triple_vector carry((a | b) & ~register_state);
+                     register_state = sum | carry;
+                     do_not_optimize(register_state);
+                 }
+             }},
+            {"cycle_temporaries_arena", [](Bench_state &state)
+             {
+                 Triple_vector a(random_signals(state.get_size(), 1));
+                 Triple_vector b(random_signals(state.get_size(), 2));
+                 Triple_vector register_state(random_signals(state.get_size(), 3));
+                 Triple_signal::Triple_cycle_arena arena;
+                 while (state.keep_running())
+                 {
+                     {
+                         Triple_vector sum(a & b, &arena);
+                         Triple_vector carry((a | b) & ~register_state, &arena);
+                         Triple_vector next(sum | carry, &arena);
+                         register_state = next;
+                     }
+                     arena.reset();
+                     do_not_optimize(register_state);
+                 }
+             }},
+        };
+    }
+
+    size_t parse_size(const char *text)
+    {
+        return static_cast<size_t>(std::strtod(text, nullptr));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string filter;
+    size_t max_size = 100000000;
+    double min_time = 0.1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument.rfind("--filter=", 0) == 0)
+            filter = argument.substr(9);
+        else if (argument.rfind("--max_size=", 0) == 0)
+            max_size = parse_size(argv[i] + 11);
+        else if (argument.rfind("--min_time=", 0) == 0)
+            min_time = std::strtod(argv[i] + 11, nullptr);
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--filter=substring] [--max_size=N] [--min_time=seconds]\n";
+            return 1;
+        }
+    }
+
+    const size_t sizes[] = {8, 64, 1000, 65536, 1000000, 16777216, 100000000};
+
+    std::cout << std::left << std::setw(36) << "Benchmark" << std::right
+              << std::setw(16) << "Time, ns" << std::setw(12) << "Iterations"
+              << std::setw(14) << "ns/signal" << std::setw(16) << "bytes/signal"
+              << std::setw(14) << "allocs/iter" << "\n"
+              << std::string(108, '-') << "\n";
+
+    for (const Benchmark &benchmark : benchmarks())
+    {
+        for (size_t size : sizes)
+        {
+            std::string name = std::string(benchmark.name) + "/" + std::to_string(size);
+            if (size > max_size || name.find(filter) == std::string::npos)
+                continue;
+
+            Bench_state state(size, min_time);
+            benchmark.body(state);
+
+            double iterations = static_cast<double>(state.get_iterations());
+            double time_ns = state.elapsed * 1e9 / iterations;
+            std::cout << std::left << std::setw(36) << name << std::right << std::fixed
+                      << std::setw(16) << std::setprecision(1) << time_ns
+                      << std::setw(12) << state.get_iterations()
+                      << std::setw(14) << std::setprecision(4) << time_ns / size
+                      << std::setw(16) << std::setprecision(4) << state.bytes / iterations / size
+                      << std::setw(14) << std::setprecision(2) << state.allocations / iterations << "\n";
+        }
+    }
+
+    return 0;
+}
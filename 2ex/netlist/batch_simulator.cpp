@@ -0,0 +1,133 @@
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "batch_simulator.hpp"
+
+namespace Triple_signal
+{
+    std::vector<Triple_vector> transpose_signals(const std::vector<Triple_vector> &rows, size_t width)
+    {
+        size_t count = rows.size();
+        size_t words = Triple_vector::word_count(count);
+        std::vector<uint64_t> known(width * words, 0);
+        std::vector<uint64_t> value(width * words, 0);
+
+        // Строки читаются подряд по словам, биты раскладываются по плоскостям столбцов
+        for (size_t row = 0; row < count; row++)
+        {
+            if (rows[row].get_size() != width)
+            {
+                throw std::invalid_argument("Row " + std::to_string(row) + " has " +
+                                            std::to_string(rows[row].get_size()) +
+                                            " signals, expected " + std::to_string(width));
+            }
+
+            const uint64_t *row_known = rows[row].get_known();
+            const uint64_t *row_value = rows[row].get_value();
+            size_t word = row / 64;
+            size_t shift = row % 64;
+            for (size_t column = 0; column < width; column++)
+            {
+                known[column * words + word] |= ((row_known[column / 64] >> (column % 64)) & 1) << shift;
+                value[column * words + word] |= ((row_value[column / 64] >> (column % 64)) & 1) << shift;
+            }
+        }
+
+        std::vector<Triple_vector> columns;
+        columns.reserve(width);
+        for (size_t column = 0; column < width; column++)
+        {
+            columns.emplace_back(Triple_vector_view(known.data() + column * words,
+                                                    value.data() + column * words, 0, count));
+        }
+        return columns;
+    }
+
+    Batch_simulator::Batch_simulator(size_t patterns) : patterns(patterns)
+    {
+        if (patterns == 0)
+            throw std::invalid_argument("pattern count must be positive");
+        if (patterns > static_cast<size_t>(std::numeric_limits<int>::max()))
+            throw std::invalid_argument("pattern count " + std::to_string(patterns) + " is too large");
+    }
+
+    size_t Batch_simulator::add_input()
+    {
+        size_t net = netlist.add_net(patterns);
+        inputs.push_back(net);
+        return net;
+    }
+
+    size_t Batch_simulator::add_net()
+    {
+        return netlist.add_net(patterns);
+    }
+
+    void Batch_simulator::add_gate(Gate_type type, const std::vector<size_t> &inputs, size_t output)
+    {
+        netlist.add_gate(type, inputs, output);
+    }
+
+    size_t Batch_simulator::add_gate(Gate_type type, const std::vector<size_t> &inputs)
+    {
+        return netlist.add_gate(type, inputs);
+    }
+
+    void Batch_simulator::set_patterns(const std::vector<Triple_vector> &stimuli)
+    {
+        if (stimuli.size() != patterns)
+        {
+            throw std::invalid_argument("Expected " + std::to_string(patterns) +
+                                        " patterns, got " + std::to_string(stimuli.size()));
+        }
+
+        std::vector<Triple_vector> lanes = transpose_signals(stimuli, inputs.size());
+        for (size_t i = 0; i < inputs.size(); i++)
+            netlist.set_input(inputs[i], lanes[i]);
+    }
+
+    void Batch_simulator::evaluate()
+    {
+        netlist.evaluate();
+    }
+
+    const Triple_vector &Batch_simulator::get_lanes(size_t net) const
+    {
+        return netlist.get_value(net);
+    }
+
+    Triple_vector Batch_simulator::get_response(size_t pattern, const std::vector<size_t> &nets) const
+    {
+        if (pattern >= patterns)
+        {
+            throw std::out_of_range("Pattern " + std::to_string(pattern) +
+                                    " out of range for batch of " + std::to_string(patterns));
+        }
+
+        Triple_vector response;
+        response.reserve(nets.size());
+        for (size_t net : nets)
+            response.push_back(netlist.get_value(net)[pattern]);
+        return response;
+    }
+
+    std::vector<Triple_vector> Batch_simulator::get_responses(const std::vector<size_t> &nets) const
+    {
+        std::vector<Triple_vector> lanes;
+        lanes.reserve(nets.size());
+        for (size_t net : nets)
+            lanes.push_back(netlist.get_value(net));
+        return transpose_signals(lanes, patterns);
+    }
+
+    size_t Batch_simulator::get_pattern_count() const
+    {
+        return patterns;
+    }
+
+    const Netlist &Batch_simulator::get_netlist() const
+    {
+        return netlist;
+    }
+}
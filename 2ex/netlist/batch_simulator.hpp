@@ -0,0 +1,144 @@
+/**
+ * @file batch_simulator.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий параллельную по шаблонам симуляцию схемы
+ * @version 0.1
+ * @date 2025-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef BATCH_SIMULATOR_H
+#define BATCH_SIMULATOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include "netlist.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Транспонирует матрицу сигналов
+     *
+     * rows[r][c] становится result[c][r]
+     *
+     * @param rows Строки одинаковой ширины
+     * @param width Ширина строк
+     * @return std::vector<Triple_vector> width векторов по rows.size() сигналов
+     * @throw std::invalid_argument ширина строки не равна width
+     */
+    std::vector<Triple_vector> transpose_signals(const std::vector<Triple_vector> &rows, size_t width);
+
+    /**
+     * @brief Симуляция однобитной схемы сразу на множестве входных шаблонов
+     *
+     * Каждая цепь хранит Triple_vector из patterns сигналов: сигнал i - значение цепи
+     * на i-м шаблоне. Вентили Netlist вычисляются ядрами Triple_vector, поэтому за одну
+     * инструкцию обрабатывается 64-512 шаблонов с той же таблицей истинности,
+     * что у операторов &&, ||, ! класса Triple_signal.
+     */
+    class Batch_simulator
+    {
+        Netlist netlist;
+        size_t patterns;
+        std::vector<size_t> inputs;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * @param patterns Число шаблонов, моделируемых за один проход
+         * @throw std::invalid_argument число шаблонов равно нулю или больше INT_MAX
+         */
+        explicit Batch_simulator(size_t patterns);
+
+        /**
+         * @brief Добавляет вход схемы
+         *
+         * Входы нумеруются в порядке добавления, этот порядок задает сигналы шаблона
+         *
+         * @return size_t Номер цепи
+         */
+        size_t add_input();
+
+        /**
+         * @brief Добавляет цепь без драйвера (для ссылок на еще не добавленные вентили)
+         *
+         * @return size_t Номер цепи
+         */
+        size_t add_net();
+
+        /**
+         * @brief Добавляет вентиль, управляющий существующей цепью
+         *
+         * @see Netlist::add_gate
+         */
+        void add_gate(Gate_type type, const std::vector<size_t> &inputs, size_t output);
+
+        /**
+         * @brief Добавляет вентиль вместе с новой выходной цепью
+         *
+         * @see Netlist::add_gate
+         * @return size_t Номер выходной цепи
+         */
+        size_t add_gate(Gate_type type, const std::vector<size_t> &inputs);
+
+        /**
+         * @brief Задает входные шаблоны
+         *
+         * @param stimuli Ровно patterns векторов, сигнал i вектора - значение i-го входа
+         * @throw std::invalid_argument число шаблонов или их ширина не совпадает со схемой
+         */
+        void set_patterns(const std::vector<Triple_vector> &stimuli);
+
+        /**
+         * @brief Вычисляет схему на всех шаблонах
+         *
+         * @throw std::logic_error в схеме есть комбинационная петля
+         */
+        void evaluate();
+
+        /**
+         * @brief Значения цепи на всех шаблонах
+         *
+         * @param net Номер цепи
+         * @return const Triple_vector& Сигнал i - значение на i-м шаблоне
+         */
+        const Triple_vector &get_lanes(size_t net) const;
+
+        /**
+         * @brief Значения цепей на одном шаблоне
+         *
+         * @param pattern Номер шаблона
+         * @param nets Цепи
+         * @return Triple_vector Сигнал i - значение цепи nets[i]
+         * @throw std::out_of_range номер шаблона или цепи вне диапазона
+         */
+        Triple_vector get_response(size_t pattern, const std::vector<size_t> &nets) const;
+
+        /**
+         * @brief Значения цепей на всех шаблонах
+         *
+         * @param nets Цепи
+         * @return std::vector<Triple_vector> patterns векторов, сигнал i - значение цепи nets[i]
+         */
+        std::vector<Triple_vector> get_responses(const std::vector<size_t> &nets) const;
+
+        /**
+         * @brief Число шаблонов
+         *
+         * @return size_t
+         */
+        size_t get_pattern_count() const;
+
+        /**
+         * @brief Схема
+         *
+         * @return const Netlist&
+         */
+        const Netlist &get_netlist() const;
+    };
+}
+
+#endif
@@ -0,0 +1,240 @@
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "netlist.hpp"
+
+namespace Triple_signal
+{
+    void Netlist::check_net(size_t net) const
+    {
+        if (net >= values.size())
+        {
+            throw std::invalid_argument("Net " + std::to_string(net) +
+                                        " does not exist in netlist of " +
+                                        std::to_string(values.size()) + " nets");
+        }
+    }
+
+    void Netlist::levelize()
+    {
+        // Алгоритм Кана: уровень вентиля на единицу больше максимального уровня его драйверов
+        std::vector<size_t> waiting(gates.size(), 0);
+        std::vector<size_t> ready;
+        for (Gate &gate : gates)
+        {
+            gate.level = 0;
+            for (size_t next : fanouts[gate.output])
+                waiting[next]++;
+        }
+        for (size_t i = 0; i < gates.size(); i++)
+        {
+            if (waiting[i] == 0)
+                ready.push_back(i);
+        }
+
+        size_t depth = 0;
+        size_t processed = 0;
+        while (!ready.empty())
+        {
+            size_t gate = ready.back();
+            ready.pop_back();
+            processed++;
+            depth = std::max(depth, gates[gate].level + 1);
+
+            for (size_t next : fanouts[gates[gate].output])
+            {
+                gates[next].level = std::max(gates[next].level, gates[gate].level + 1);
+                if (--waiting[next] == 0)
+                    ready.push_back(next);
+            }
+        }
+
+        if (processed != gates.size())
+            throw std::logic_error("combinational loop in netlist");
+
+        schedule.assign(depth, {});
+        levelized = true;
+
+        // После перестроения порядка все вентили пересчитываются один раз
+        for (size_t i = 0; i < gates.size(); i++)
+        {
+            gates[i].queued = false;
+            enqueue(i);
+        }
+    }
+
+    void Netlist::enqueue(size_t gate)
+    {
+        if (!gates[gate].queued)
+        {
+            gates[gate].queued = true;
+            schedule[gates[gate].level].push_back(gate);
+        }
+    }
+
+    void Netlist::enqueue_fanout(size_t net)
+    {
+        for (size_t gate : fanouts[net])
+            enqueue(gate);
+    }
+
+    void Netlist::evaluate_gate(const Gate &gate)
+    {
+        const std::vector<size_t> &inputs = gate.inputs;
+        switch (gate.type)
+        {
+        case Gate_type::AND:
+            scratch = values[inputs[0]] & values[inputs[1]];
+            for (size_t i = 2; i < inputs.size(); i++)
+                scratch = scratch & values[inputs[i]];
+            break;
+        case Gate_type::OR:
+            scratch = values[inputs[0]] | values[inputs[1]];
+            for (size_t i = 2; i < inputs.size(); i++)
+                scratch = scratch | values[inputs[i]];
+            break;
+        case Gate_type::NOT:
+            scratch = ~values[inputs[0]];
+            break;
+        case Gate_type::BUF:
+            scratch = values[inputs[0]];
+            break;
+        }
+    }
+
+    size_t Netlist::add_net(size_t width)
+    {
+        if (width == 0)
+            throw std::invalid_argument("net width must be positive");
+        // Triple_vector создается из int, большая ширина усеклась бы молча
+        if (width > static_cast<size_t>(std::numeric_limits<int>::max()))
+            throw std::invalid_argument("net width " + std::to_string(width) + " is too large");
+
+        values.emplace_back(static_cast<int>(width));
+        drivers.push_back(no_driver);
+        fanouts.emplace_back();
+        return values.size() - 1;
+    }
+
+    void Netlist::add_gate(Gate_type type, const std::vector<size_t> &inputs, size_t output)
+    {
+        bool single = type == Gate_type::NOT || type == Gate_type::BUF;
+        if (single ? inputs.size() != 1 : inputs.size() < 2)
+            throw std::invalid_argument("wrong number of gate inputs: " + std::to_string(inputs.size()));
+
+        check_net(output);
+        for (size_t input : inputs)
+        {
+            check_net(input);
+            if (values[input].get_size() != values[output].get_size())
+                throw std::invalid_argument("gate inputs and output have different widths");
+        }
+        if (drivers[output] != no_driver)
+            throw std::invalid_argument("Net " + std::to_string(output) + " already has a driver");
+
+        size_t gate = gates.size();
+        gates.push_back({type, inputs, output});
+        drivers[output] = gate;
+        for (size_t input : inputs)
+        {
+            // Вентиль, читающий одну цепь дважды, получает одно событие
+            if (fanouts[input].empty() || fanouts[input].back() != gate)
+                fanouts[input].push_back(gate);
+        }
+        levelized = false;
+    }
+
+    size_t Netlist::add_gate(Gate_type type, const std::vector<size_t> &inputs)
+    {
+        if (inputs.empty())
+            throw std::invalid_argument("wrong number of gate inputs: 0");
+        check_net(inputs[0]);
+
+        size_t output = add_net(values[inputs[0]].get_size());
+        try
+        {
+            add_gate(type, inputs, output);
+        }
+        catch (...)
+        {
+            values.pop_back();
+            drivers.pop_back();
+            fanouts.pop_back();
+            throw;
+        }
+        return output;
+    }
+
+    void Netlist::set_input(size_t net, const Triple_vector &signals)
+    {
+        check_net(net);
+        if (drivers[net] != no_driver)
+            throw std::invalid_argument("Net " + std::to_string(net) + " is driven by a gate");
+        if (signals.get_size() != values[net].get_size())
+            throw std::invalid_argument("input width does not match net width");
+
+        if (values[net] == signals)
+            return;
+        values[net] = signals;
+        if (levelized)
+            enqueue_fanout(net);
+    }
+
+    void Netlist::evaluate()
+    {
+        if (!levelized)
+            levelize();
+
+        evaluations = 0;
+        for (std::vector<size_t> &level : schedule)
+        {
+            // Нагрузка вентиля всегда на более высоком уровне, поэтому текущий уровень не растет
+            for (size_t gate : level)
+            {
+                Gate &current = gates[gate];
+                current.queued = false;
+                evaluations++;
+
+                evaluate_gate(current);
+                if (scratch != values[current.output])
+                {
+                    std::swap(scratch, values[current.output]);
+                    enqueue_fanout(current.output);
+                }
+            }
+            level.clear();
+        }
+    }
+
+    const Triple_vector &Netlist::get_value(size_t net) const
+    {
+        if (net >= values.size())
+            throw std::out_of_range("Net " + std::to_string(net) + " does not exist");
+        return values[net];
+    }
+
+    size_t Netlist::get_net_count() const
+    {
+        return values.size();
+    }
+
+    size_t Netlist::get_gate_count() const
+    {
+        return gates.size();
+    }
+
+    size_t Netlist::get_depth()
+    {
+        if (!levelized)
+            levelize();
+        return schedule.size();
+    }
+
+    size_t Netlist::get_evaluations() const
+    {
+        return evaluations;
+    }
+}
@@ -0,0 +1,164 @@
+/**
+ * @file netlist.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий событийный симулятор схем из троичных вентилей
+ * @version 0.1
+ * @date 2025-10-15
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../triple_vector/triple_vector.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Тип вентиля
+     *
+     */
+    enum class Gate_type
+    {
+        AND, ///< Поразрядное И двух и более шин
+        OR,  ///< Поразрядное ИЛИ двух и более шин
+        NOT, ///< Поразрядное НЕ одной шины
+        BUF  ///< Повторитель одной шины
+    };
+
+    /**
+     * @brief Комбинационная схема из вентилей над шинами Triple_vector
+     *
+     * Цепи (шины) нумеруются с нуля в порядке создания, все сигналы цепи изначально неопределены.
+     * Цепь без драйвера - вход схемы, ее значение задается через set_input.
+     * Перед вычислением вентили упорядочиваются по уровням (топологически),
+     * после чего evaluate пересчитывает только вентили, у которых изменился хотя бы один вход.
+     */
+    class Netlist
+    {
+        struct Gate
+        {
+            Gate_type type;
+            std::vector<size_t> inputs;
+            size_t output;
+            size_t level = 0;
+            bool queued = false;
+        };
+
+        static constexpr size_t no_driver = static_cast<size_t>(-1);
+
+        std::vector<Triple_vector> values;
+        std::vector<size_t> drivers;
+        std::vector<std::vector<size_t>> fanouts;
+        std::vector<Gate> gates;
+
+        std::vector<std::vector<size_t>> schedule;
+        bool levelized = false;
+        size_t evaluations = 0;
+        Triple_vector scratch;
+
+        void check_net(size_t net) const;
+        void levelize();
+        void enqueue(size_t gate);
+        void enqueue_fanout(size_t net);
+        void evaluate_gate(const Gate &gate);
+
+    public:
+        /**
+         * @brief Добавляет цепь
+         *
+         * @param width Ширина шины
+         * @return size_t Номер цепи
+         * @throw std::invalid_argument ширина не больше нуля или больше INT_MAX
+         */
+        size_t add_net(size_t width);
+
+        /**
+         * @brief Добавляет вентиль, управляющий существующей цепью
+         *
+         * Позволяет ссылаться на цепи, драйвер которых еще не добавлен
+         *
+         * @param type Тип вентиля
+         * @param inputs Входные цепи
+         * @param output Выходная цепь
+         * @throw std::invalid_argument неверное число входов, несовпадение ширин,
+         * несуществующая цепь или у выхода уже есть драйвер
+         */
+        void add_gate(Gate_type type, const std::vector<size_t> &inputs, size_t output);
+
+        /**
+         * @brief Добавляет вентиль вместе с новой выходной цепью ширины входов
+         *
+         * @param type Тип вентиля
+         * @param inputs Входные цепи
+         * @return size_t Номер выходной цепи
+         * @throw std::invalid_argument неверное число входов, несовпадение ширин или несуществующая цепь
+         */
+        size_t add_gate(Gate_type type, const std::vector<size_t> &inputs);
+
+        /**
+         * @brief Задает значение входа схемы
+         *
+         * Если значение изменилось, вентили, читающие цепь, ставятся в очередь на пересчет
+         *
+         * @param net Входная цепь
+         * @param signals Новое значение
+         * @throw std::invalid_argument цепь не существует, имеет драйвер или другую ширину
+         */
+        void set_input(size_t net, const Triple_vector &signals);
+
+        /**
+         * @brief Распространяет изменения входов по схеме
+         *
+         * Вентили обрабатываются по возрастанию уровня,
+         * изменение выхода ставит в очередь только его нагрузку
+         *
+         * @throw std::logic_error в схеме есть комбинационная петля
+         */
+        void evaluate();
+
+        /**
+         * @brief Значение цепи
+         *
+         * @param net Номер цепи
+         * @return const Triple_vector&
+         * @throw std::out_of_range цепь не существует
+         */
+        const Triple_vector &get_value(size_t net) const;
+
+        /**
+         * @brief Количество цепей
+         *
+         * @return size_t
+         */
+        size_t get_net_count() const;
+
+        /**
+         * @brief Количество вентилей
+         *
+         * @return size_t
+         */
+        size_t get_gate_count() const;
+
+        /**
+         * @brief Число уровней схемы (глубина)
+         *
+         * @return size_t
+         * @throw std::logic_error в схеме есть комбинационная петля
+         */
+        size_t get_depth();
+
+        /**
+         * @brief Сколько вентилей пересчитал последний вызов evaluate
+         *
+         * @return size_t
+         */
+        size_t get_evaluations() const;
+    };
+}
+
+#endif
@@ -1,9 +1,25 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 #include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <thread>
 
 #include "../triple_signal/triple_signal.hpp"
 #include "../triple_vector/triple_vector.hpp"
+#include "../triple_vector/triple_kernels.hpp"
+#include "../triple_vector/triple_parallel.hpp"
+#include "../triple_vector/triple_intern.hpp"
+#include "../triple_vector/triple_vector_fixed.hpp"
+#include "../triple_vector/triple_reduce.hpp"
+#include "../triple_vector/triple_atomic_vector.hpp"
+#include "../triple_vector/triple_arena.hpp"
+#include "../waveform/waveform.hpp"
+#include "../waveform/mapped_vector.hpp"
+#include "../netlist/netlist.hpp"
+#include "../netlist/batch_simulator.hpp"
+#include "../bdd/bdd.hpp"
 
 std::string get_vector_signals(Triple_signal::Triple_vector vec)
 {
@@ -185,6 +201,7 @@ TEST_CASE("Тестирование сложного класса")
 
         REQUIRE(size == 5);
         REQUIRE((array[0]).get_signal_char() == '1');
+        delete[] array;
 
         REQUIRE(!(vector.is_known()));
 
@@ -253,7 +270,7 @@ TEST_CASE("Тестирование сложного класса")
 
             vector_1.set_signals("11101");
 
-            REQUIRE(!(vector_1) == 1);
+            REQUIRE((!vector_1) == 1);
         }
     }
 
@@ -318,4 +335,1573 @@ TEST_CASE("Тестирование сложного класса")
             REQUIRE(out.str() == "1101X");
         }
     }
-}
\ No newline at end of file
+}
+std::string make_signals(size_t size, size_t seed)
+{
+    const char alphabet[] = "01X";
+    std::string result;
+    for (size_t i = 0; i < size; i++)
+    {
+        result += alphabet[(i * 7 + seed * 13 + i / 5) % 3];
+    }
+    return result;
+}
+
+char expected_and(char a, char b)
+{
+    if (a == '0' || b == '0')
+        return '0';
+    return (a == '1' && b == '1') ? '1' : 'X';
+}
+
+char expected_or(char a, char b)
+{
+    if (a == '1' || b == '1')
+        return '1';
+    return (a == '0' && b == '0') ? '0' : 'X';
+}
+
+char expected_not(char a)
+{
+    return a == '0' ? '1' : (a == '1' ? '0' : 'X');
+}
+
+TEST_CASE("Упакованное хранение вектора")
+{
+    SECTION("Операции через границы слов")
+    {
+        std::string signals_1 = make_signals(200, 1);
+        std::string signals_2 = make_signals(150, 2);
+        Triple_signal::Triple_vector vector_1(signals_1);
+        Triple_signal::Triple_vector vector_2(signals_2);
+
+        std::string and_result, or_result, not_result;
+        for (size_t i = 0; i < signals_2.size(); i++)
+        {
+            and_result += expected_and(signals_1[i], signals_2[i]);
+            or_result += expected_or(signals_1[i], signals_2[i]);
+        }
+        for (char c : signals_1)
+            not_result += expected_not(c);
+
+        REQUIRE(Triple_signal::Triple_vector(vector_1 & vector_2).get_signals() == and_result);
+        REQUIRE(Triple_signal::Triple_vector(vector_1 | vector_2).get_signals() == or_result);
+        REQUIRE(Triple_signal::Triple_vector(~vector_1).get_signals() == not_result);
+        REQUIRE(Triple_signal::Triple_vector(vector_1 + vector_2).get_signals() == signals_1 + signals_2);
+        REQUIRE(Triple_signal::Triple_vector(vector_2 + vector_1).get_signals() == signals_2 + signals_1);
+    }
+    SECTION("Срез через границу слова")
+    {
+        std::string signals = make_signals(300, 3);
+        Triple_signal::Triple_vector vector(signals);
+
+        REQUIRE(vector[{60, 199}].get_signals() == signals.substr(60, 140));
+        REQUIRE(vector[{0, 299}] == vector);
+        REQUIRE(vector[{299, 299}].get_signals() == signals.substr(299, 1));
+    }
+    SECTION("Определенность и сравнение")
+    {
+        Triple_signal::Triple_vector vector(std::string(129, '1'));
+        REQUIRE(vector.is_known());
+
+        vector[128] = Triple_signal::Triple_signal('x');
+        REQUIRE(!vector.is_known());
+        REQUIRE(vector != Triple_signal::Triple_vector(std::string(129, '1')));
+
+        vector[128] = Triple_signal::Triple_signal('1');
+        REQUIRE(vector == Triple_signal::Triple_vector(std::string(129, '1')));
+        REQUIRE(vector.get_size() == 129);
+    }
+}
+
+TEST_CASE("Ядра троичной логики")
+{
+    namespace kernels = Triple_signal::kernels;
+
+    std::string signals_1 = make_signals(1500, 4);
+    std::string signals_2 = make_signals(1300, 5);
+    Triple_signal::Triple_vector vector_1(signals_1);
+    Triple_signal::Triple_vector vector_2(signals_2);
+
+    kernels::Isa detected = kernels::detect_isa();
+    REQUIRE(kernels::set_isa(kernels::Isa::SCALAR));
+    Triple_signal::Triple_vector and_result = vector_1 & vector_2;
+    Triple_signal::Triple_vector or_result = vector_1 | vector_2;
+    Triple_signal::Triple_vector not_result = ~vector_1;
+
+    for (kernels::Isa isa : {kernels::Isa::SSE2, kernels::Isa::AVX2, kernels::Isa::AVX512})
+    {
+        if (!kernels::set_isa(isa))
+            continue;
+
+        REQUIRE(kernels::get_isa() == isa);
+        REQUIRE((vector_1 & vector_2) == and_result);
+        REQUIRE((vector_1 | vector_2) == or_result);
+        REQUIRE((~vector_1) == not_result);
+        REQUIRE(Triple_signal::Triple_vector(std::string(1000, '0')).is_known());
+        REQUIRE(!Triple_signal::Triple_vector(std::string(999, '0') + "X").is_known());
+        REQUIRE(!Triple_signal::Triple_vector("X" + std::string(999, '1')).is_known());
+    }
+
+    REQUIRE(kernels::set_isa(detected));
+}
+
+TEST_CASE("Ленивые выражения")
+{
+    std::string signals_a = make_signals(300, 6);
+    std::string signals_b = make_signals(280, 7);
+    std::string signals_c = make_signals(290, 8);
+    Triple_signal::Triple_vector a(signals_a), b(signals_b), c(signals_c);
+
+    SECTION("Составное выражение за один проход")
+    {
+        Triple_signal::Triple_vector fused = (a & b) | ~c;
+
+        Triple_signal::Triple_vector a_and_b = a & b;
+        Triple_signal::Triple_vector not_c = ~c;
+        Triple_signal::Triple_vector stepwise = a_and_b | not_c;
+
+        REQUIRE(fused == stepwise);
+        REQUIRE(fused.get_size() == 280);
+        REQUIRE(((a & b) | ~c) == stepwise);
+        REQUIRE(((a & b) | ~c) != (a & b));
+    }
+    SECTION("Конкатенация внутри выражения")
+    {
+        Triple_signal::Triple_vector joined = ~(b + a) + Triple_signal::Triple_signal('1');
+
+        std::string expected;
+        for (char signal : signals_b + signals_a)
+            expected += expected_not(signal);
+        expected += '1';
+
+        REQUIRE(joined.get_signals() == expected);
+    }
+    SECTION("Вектор в собственном выражении")
+    {
+        Triple_signal::Triple_vector expected = a + a;
+        a = a + a;
+        REQUIRE(a == expected);
+
+        Triple_signal::Triple_vector masked = b & c;
+        b = b & c;
+        REQUIRE(b == masked);
+    }
+    SECTION("Вычисление в собственный буфер")
+    {
+        const uint64_t *planes = b.get_known();
+        Triple_signal::Triple_vector expected = (b & c) | a;
+        b = (b & c) | a;
+        REQUIRE(b == expected);
+        REQUIRE(b.get_known() == planes);
+
+        // Сужение: слова за новым концом обнуляются, дописывание видит чистый хвост
+        Triple_signal::Triple_vector narrow(make_signals(100, 9));
+        expected = (b & narrow) + c;
+        b = b & narrow;
+        REQUIRE(b.get_size() == 100);
+        REQUIRE(b.get_known() == planes);
+        b += c;
+        REQUIRE(b == expected);
+
+        // Срез себя со сдвигом и разделяемый буфер вычисляются в новый буфер
+        std::string before = b.get_signals();
+        expected = Triple_signal::Triple_vector(before.substr(1, 99)) & c;
+        b = b[{1, 99}] & c;
+        REQUIRE(b == expected);
+
+        Triple_signal::Triple_vector shared = b;
+        b = b | c;
+        REQUIRE(shared == expected);
+        REQUIRE(b == (expected | c));
+    }
+    SECTION("Вывод выражения")
+    {
+        std::stringstream out;
+        out << (Triple_signal::Triple_vector("10X") | Triple_signal::Triple_vector("0X0"));
+        REQUIRE(out.str() == "1XX");
+    }
+}
+
+TEST_CASE("Представление подвектора")
+{
+    std::string signals = make_signals(400, 9);
+    Triple_signal::Triple_vector vector(signals);
+
+    SECTION("Срез не копирует сигналы")
+    {
+        Triple_signal::Triple_vector_view view = vector[{70, 169}];
+        REQUIRE(view.get_size() == 100);
+        REQUIRE(view.get_signals() == signals.substr(70, 100));
+
+        vector[75] = Triple_signal::Triple_signal('1');
+        REQUIRE(view[5].get_signal_char() == '1');
+        REQUIRE_THROWS_AS(view[100], std::out_of_range);
+    }
+    SECTION("Срез представления")
+    {
+        Triple_signal::Triple_vector_view view = vector[{10, 309}];
+        Triple_signal::Triple_vector_view inner = view[{60, 129}];
+
+        REQUIRE(inner.get_signals() == signals.substr(70, 70));
+        REQUIRE(inner == vector[{70, 139}]);
+        REQUIRE_THROWS_AS(view[std::make_pair(5, 1)], std::invalid_argument);
+        REQUIRE_THROWS_AS(view[std::make_pair(1, 300)], std::out_of_range);
+    }
+    SECTION("Логические операции над представлениями")
+    {
+        Triple_signal::Triple_vector_view low = vector[{3, 202}];
+        Triple_signal::Triple_vector_view high = vector[{190, 389}];
+
+        Triple_signal::Triple_vector low_copy = low;
+        Triple_signal::Triple_vector high_copy = high;
+
+        REQUIRE((low & high) == (low_copy & high_copy));
+        REQUIRE((low | ~high) == (low_copy | ~high_copy));
+        REQUIRE(Triple_signal::Triple_vector(low + high).get_signals() == signals.substr(3, 200) + signals.substr(190, 200));
+        REQUIRE(low != high);
+    }
+    SECTION("Определенность и вывод")
+    {
+        Triple_signal::Triple_vector known_vector("X" + std::string(130, '1') + "X");
+        REQUIRE(known_vector[{1, 130}].is_known());
+        REQUIRE(!known_vector[{0, 130}].is_known());
+        REQUIRE(!known_vector[{1, 130}]);
+
+        std::stringstream out;
+        out << known_vector[{0, 2}];
+        REQUIRE(out.str() == "X11");
+    }
+}
+
+TEST_CASE("Встроенный буфер коротких векторов")
+{
+    std::string short_signals = make_signals(Triple_signal::Triple_vector::inline_bits == 0 ? 1 : Triple_signal::Triple_vector::inline_bits, 10);
+    std::string long_signals = make_signals(Triple_signal::Triple_vector::inline_bits + 70, 11);
+
+    SECTION("Копирование и перемещение")
+    {
+        Triple_signal::Triple_vector small(short_signals);
+        Triple_signal::Triple_vector copy(small);
+        copy[0] = Triple_signal::Triple_signal(short_signals[0] == '1' ? '0' : '1');
+        REQUIRE(small.get_signals() == short_signals);
+
+        Triple_signal::Triple_vector moved(std::move(small));
+        REQUIRE(moved.get_signals() == short_signals);
+        REQUIRE(small.get_signals() == "");
+
+        small = std::move(moved);
+        REQUIRE(small.get_signals() == short_signals);
+        REQUIRE(moved.get_signals() == "");
+    }
+    SECTION("Переход между встроенным буфером и кучей")
+    {
+        Triple_signal::Triple_vector vector(short_signals);
+        Triple_signal::Triple_vector big(long_signals);
+
+        vector = big;
+        REQUIRE(vector.get_signals() == long_signals);
+
+        vector = Triple_signal::Triple_vector(short_signals);
+        REQUIRE(vector.get_signals() == short_signals);
+
+        big = std::move(vector);
+        REQUIRE(big.get_signals() == short_signals);
+        REQUIRE(big == Triple_signal::Triple_vector(short_signals));
+        REQUIRE(Triple_signal::Triple_vector(big + big).get_signals() == short_signals + short_signals);
+    }
+}
+
+TEST_CASE("Разбор и вывод строк сигналов")
+{
+    namespace kernels = Triple_signal::kernels;
+
+    std::string signals = make_signals(1000, 12);
+    std::string lower = signals;
+    std::replace(lower.begin(), lower.end(), 'X', 'x');
+
+    kernels::Isa detected = kernels::detect_isa();
+    for (kernels::Isa isa : {kernels::Isa::SCALAR, kernels::Isa::SSE2, kernels::Isa::AVX2, kernels::Isa::AVX512})
+    {
+        if (!kernels::set_isa(isa))
+            continue;
+
+        REQUIRE(Triple_signal::Triple_vector(lower).get_signals() == signals);
+
+        std::string_view middle = std::string_view(signals).substr(37, 500);
+        REQUIRE(Triple_signal::Triple_vector(middle).get_signals() == middle);
+
+        for (size_t position : {0, 15, 31, 63, 64, 130, 999})
+        {
+            std::string broken = signals;
+            broken[position] = '2';
+
+            Triple_signal::Triple_vector vector("101");
+            REQUIRE_THROWS_AS(vector.set_signals(broken), std::invalid_argument);
+            REQUIRE(vector.get_signals() == "101");
+        }
+    }
+    REQUIRE(kernels::set_isa(detected));
+
+    REQUIRE(Triple_signal::Triple_vector(std::string_view()).get_signals() == "");
+}
+
+TEST_CASE("Потоковые файлы векторов")
+{
+    std::vector<std::string> lines = {make_signals(1, 1), make_signals(64, 2), make_signals(5000, 3),
+                                      make_signals(10000, 4), make_signals(130, 5)};
+
+    SECTION("Текстовый формат")
+    {
+        std::stringstream file;
+        Triple_signal::Waveform_text_writer writer(file);
+        for (const std::string &line : lines)
+            writer.write(Triple_signal::Triple_vector(line));
+        REQUIRE(file.str().size() == 1 + 64 + 5000 + 10000 + 130 + lines.size());
+
+        // Маленький буфер заставляет строки пересекать границы чтения
+        Triple_signal::Waveform_text_reader reader(file, 100);
+        Triple_signal::Triple_vector vector;
+        for (const std::string &line : lines)
+        {
+            REQUIRE(reader.next(vector));
+            REQUIRE(vector.get_signals() == line);
+        }
+        REQUIRE(!reader.next(vector));
+        REQUIRE(reader.get_line() == lines.size());
+    }
+
+    SECTION("Пустые строки, CRLF и строчные x")
+    {
+        std::string long_line(4095, 'x');
+        std::stringstream file("10x\r\n\n" + long_line + "\r\n\r\n01");
+        Triple_signal::Waveform_text_reader reader(file, 64);
+        Triple_signal::Triple_vector vector;
+
+        REQUIRE(reader.next(vector));
+        REQUIRE(vector.get_signals() == "10X");
+        REQUIRE(reader.next(vector));
+        REQUIRE(vector.get_signals() == std::string(4095, 'X'));
+        REQUIRE(reader.next(vector));
+        REQUIRE(vector.get_signals() == "01");
+        REQUIRE(reader.get_line() == 5);
+        REQUIRE(!reader.next(vector));
+    }
+
+    SECTION("Ошибка в тексте")
+    {
+        std::stringstream file("101\n" + std::string(5000, '1') + "2\n");
+        Triple_signal::Waveform_text_reader reader(file, 256);
+        Triple_signal::Triple_vector vector;
+
+        REQUIRE(reader.next(vector));
+        REQUIRE_THROWS_AS(reader.next(vector), std::invalid_argument);
+    }
+
+    SECTION("Двоичный формат")
+    {
+        std::stringstream file;
+        Triple_signal::Waveform_binary_writer writer(file);
+        for (const std::string &line : lines)
+            writer.write(Triple_signal::Triple_vector(line));
+        writer.write(Triple_signal::Triple_vector(lines[3])[{3, 2000}]);
+
+        Triple_signal::Waveform_binary_reader reader(file);
+        Triple_signal::Triple_vector vector;
+        for (const std::string &line : lines)
+        {
+            REQUIRE(reader.next(vector));
+            REQUIRE(vector.get_signals() == line);
+        }
+        REQUIRE(reader.next(vector));
+        REQUIRE(vector.get_signals() == lines[3].substr(3, 1998));
+        REQUIRE(!reader.next(vector));
+
+        std::stringstream wrong("TEXT1234");
+        REQUIRE_THROWS_AS(Triple_signal::Waveform_binary_reader(wrong), std::runtime_error);
+
+        std::string bytes = file.str();
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 8));
+        Triple_signal::Waveform_binary_reader short_reader(truncated);
+        for (size_t i = 0; i < lines.size(); i++)
+            REQUIRE(short_reader.next(vector));
+        REQUIRE_THROWS_AS(short_reader.next(vector), std::runtime_error);
+
+        // Размер записи из поврежденного файла не должен приводить к огромному выделению памяти
+        for (uint64_t size : {~uint64_t(0), uint64_t(1) << 40})
+        {
+            std::string header = bytes.substr(0, sizeof(Triple_signal::waveform_magic) + sizeof(Triple_signal::waveform_version));
+            std::stringstream corrupted(header + std::string(reinterpret_cast<const char *>(&size), sizeof(size)) +
+                                        std::string(64, '\0'));
+            Triple_signal::Waveform_binary_reader corrupted_reader(corrupted);
+            REQUIRE_THROWS_AS(corrupted_reader.next(vector), std::runtime_error);
+        }
+    }
+
+    SECTION("Отображение двоичного файла в память")
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "triple_waveform_test.bin";
+        {
+            std::ofstream file(path, std::ios::binary);
+            Triple_signal::Waveform_binary_writer writer(file);
+            for (const std::string &line : lines)
+                writer.write(Triple_signal::Triple_vector(line));
+        }
+
+        {
+            Triple_signal::Waveform_mapped_reader reader(path.string());
+            Triple_signal::Triple_vector_view view;
+            for (int pass = 0; pass < 2; pass++)
+            {
+                for (const std::string &line : lines)
+                {
+                    REQUIRE(reader.next(view));
+                    REQUIRE(view.get_signals() == line);
+                }
+                REQUIRE(!reader.next(view));
+                reader.rewind();
+            }
+        }
+
+        // value установлен там, где known сброшен: такую запись нельзя вернуть как вектор
+        {
+            std::ofstream file(path, std::ios::binary);
+            Triple_signal::Waveform_binary_writer writer(file);
+            writer.write(Triple_signal::Triple_vector("01"));
+            uint64_t record[3] = {2, 0, 1};
+            file.write(reinterpret_cast<const char *>(record), sizeof(record));
+        }
+        {
+            Triple_signal::Waveform_mapped_reader reader(path.string());
+            Triple_signal::Triple_vector_view view;
+            REQUIRE(reader.next(view));
+            REQUIRE_THROWS_AS(reader.next(view), std::runtime_error);
+        }
+        std::filesystem::remove(path);
+
+        REQUIRE_THROWS_AS(Triple_signal::Waveform_mapped_reader(path.string()), std::runtime_error);
+    }
+}
+
+TEST_CASE("Симуляция схемы")
+{
+    using Triple_signal::Gate_type;
+
+    SECTION("Полусумматор из И/ИЛИ/НЕ")
+    {
+        // sum = (a | b) & ~(a & b), carry = a & b
+        Triple_signal::Netlist netlist;
+        size_t a = netlist.add_net(4);
+        size_t b = netlist.add_net(4);
+        size_t carry = netlist.add_gate(Gate_type::AND, {a, b});
+        size_t any = netlist.add_gate(Gate_type::OR, {a, b});
+        size_t not_carry = netlist.add_gate(Gate_type::NOT, {carry});
+        size_t sum = netlist.add_gate(Gate_type::AND, {any, not_carry});
+
+        REQUIRE(netlist.get_depth() == 3);
+
+        netlist.evaluate();
+        REQUIRE(netlist.get_evaluations() == 4);
+        REQUIRE(netlist.get_value(sum).get_signals() == "XXXX");
+
+        netlist.set_input(a, Triple_signal::Triple_vector("0011"));
+        netlist.set_input(b, Triple_signal::Triple_vector("0101"));
+        netlist.evaluate();
+        REQUIRE(netlist.get_value(sum).get_signals() == "0110");
+        REQUIRE(netlist.get_value(carry).get_signals() == "0001");
+
+        netlist.set_input(b, Triple_signal::Triple_vector("X10X"));
+        netlist.evaluate();
+        REQUIRE(netlist.get_value(carry).get_signals() == "000X");
+        REQUIRE(netlist.get_value(sum).get_signals() == "X11X");
+    }
+
+    SECTION("Пересчитываются только изменившиеся вентили")
+    {
+        Triple_signal::Netlist netlist;
+        size_t left = netlist.add_net(70);
+        size_t right = netlist.add_net(70);
+        size_t left_chain = left;
+        size_t right_chain = right;
+        for (int i = 0; i < 10; i++)
+        {
+            left_chain = netlist.add_gate(Gate_type::NOT, {left_chain});
+            right_chain = netlist.add_gate(Gate_type::BUF, {right_chain});
+        }
+        size_t joined = netlist.add_gate(Gate_type::OR, {left_chain, right_chain, right});
+
+        netlist.set_input(left, Triple_signal::Triple_vector(std::string(70, '0')));
+        netlist.set_input(right, Triple_signal::Triple_vector(std::string(70, '0')));
+        netlist.evaluate();
+        REQUIRE(netlist.get_evaluations() == 21);
+        REQUIRE(netlist.get_value(joined).get_signals() == std::string(70, '0'));
+
+        netlist.set_input(right, Triple_signal::Triple_vector(std::string(70, '0')));
+        netlist.evaluate();
+        REQUIRE(netlist.get_evaluations() == 0);
+
+        std::string pattern = make_signals(70, 9);
+        netlist.set_input(left, Triple_signal::Triple_vector(pattern));
+        netlist.evaluate();
+        REQUIRE(netlist.get_evaluations() == 11);
+        REQUIRE(netlist.get_value(joined).get_signals() == pattern);
+    }
+
+    SECTION("Ошибки построения")
+    {
+        Triple_signal::Netlist netlist;
+        size_t narrow = netlist.add_net(2);
+        size_t wide = netlist.add_net(3);
+
+        REQUIRE_THROWS_AS(netlist.add_net(0), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.add_net((size_t(1) << 32) + 5), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.add_net(size_t(1) << 31), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.add_gate(Gate_type::AND, {narrow, wide}), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.add_gate(Gate_type::NOT, {narrow, narrow}), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.add_gate(Gate_type::OR, {narrow}), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.add_gate(Gate_type::BUF, {7}), std::invalid_argument);
+        REQUIRE(netlist.get_net_count() == 2);
+
+        size_t output = netlist.add_gate(Gate_type::BUF, {narrow});
+        REQUIRE_THROWS_AS(netlist.add_gate(Gate_type::BUF, {narrow}, output), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.set_input(output, Triple_signal::Triple_vector("01")), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.set_input(narrow, Triple_signal::Triple_vector("011")), std::invalid_argument);
+        REQUIRE_THROWS_AS(netlist.get_value(10), std::out_of_range);
+    }
+
+    SECTION("Комбинационная петля")
+    {
+        Triple_signal::Netlist netlist;
+        size_t input = netlist.add_net(1);
+        size_t feedback = netlist.add_net(1);
+        size_t gate = netlist.add_gate(Gate_type::AND, {input, feedback});
+        netlist.add_gate(Gate_type::NOT, {gate}, feedback);
+
+        REQUIRE_THROWS_AS(netlist.evaluate(), std::logic_error);
+    }
+}
+
+TEST_CASE("Параллельное вычисление широких векторов")
+{
+    namespace parallel = Triple_signal::parallel;
+
+    std::string signals_1 = make_signals(100000, 21);
+    std::string signals_2 = make_signals(100003, 22);
+    Triple_signal::Triple_vector vector_1(signals_1);
+    Triple_signal::Triple_vector vector_2(signals_2);
+
+    std::string expected_and_signals(100000, 'X');
+    std::string expected_or_signals(100000, 'X');
+    std::string expected_not_signals(100000, 'X');
+    for (size_t i = 0; i < 100000; i++)
+    {
+        expected_and_signals[i] = expected_and(signals_1[i], signals_2[i]);
+        expected_or_signals[i] = expected_or(signals_1[i], signals_2[i]);
+        expected_not_signals[i] = expected_not(signals_1[i]);
+    }
+
+    size_t threads = parallel::get_threads();
+    size_t threshold = parallel::get_threshold();
+    parallel::set_threads(4);
+    parallel::set_threshold(16);
+
+    REQUIRE(parallel::get_threads() == 4);
+    REQUIRE(parallel::is_parallel(1000));
+    REQUIRE(!parallel::is_parallel(8));
+
+    REQUIRE(Triple_signal::Triple_vector(vector_1 & vector_2).get_signals() == expected_and_signals);
+    REQUIRE(Triple_signal::Triple_vector(vector_1 | vector_2).get_signals() == expected_or_signals);
+    REQUIRE(Triple_signal::Triple_vector(~vector_1).get_signals() == expected_not_signals);
+    REQUIRE(Triple_signal::Triple_vector(~(vector_1 & vector_2)).get_signals() == Triple_signal::Triple_vector(~Triple_signal::Triple_vector(expected_and_signals)).get_signals());
+
+    Triple_signal::Triple_vector concat = vector_1 + vector_2;
+    REQUIRE(concat.get_signals() == signals_1 + signals_2);
+
+    Triple_signal::Triple_vector copy(signals_1);
+    REQUIRE(copy == vector_1);
+    REQUIRE((vector_1 + vector_2) == concat);
+    copy[99999] = Triple_signal::Triple_signal(signals_1[99999] == '1' ? '0' : '1');
+    REQUIRE(copy != vector_1);
+    REQUIRE((copy + vector_2) != concat);
+
+    parallel::set_threads(threads);
+    parallel::set_threshold(threshold);
+}
+
+TEST_CASE("Разделяемые буферы и интернирование")
+{
+    std::string signals = make_signals(500, 31);
+
+    SECTION("Копирование при записи")
+    {
+        Triple_signal::Triple_vector original(signals);
+        Triple_signal::Triple_vector copy = original;
+        Triple_signal::Triple_vector assigned;
+        assigned = copy;
+
+        REQUIRE(original.get_use_count() == 3);
+        REQUIRE(copy.get_known() == original.get_known());
+        REQUIRE(copy == original);
+
+        copy[10] = Triple_signal::Triple_signal(signals[10] == '1' ? '0' : '1');
+        REQUIRE(copy.get_known() != original.get_known());
+        REQUIRE(original.get_use_count() == 2);
+        REQUIRE(copy.get_use_count() == 1);
+        REQUIRE(original.get_signals() == signals);
+        REQUIRE(assigned.get_signals() == signals);
+        REQUIRE(copy != original);
+
+        Triple_signal::Triple_vector short_vector("10X");
+        Triple_signal::Triple_vector short_copy = short_vector;
+        REQUIRE(short_copy.get_use_count() == (Triple_signal::Triple_vector::inline_bits >= 3 ? 1 : 2));
+        short_copy[0] = Triple_signal::Triple_signal('0');
+        REQUIRE(short_vector.get_signals() == "10X");
+    }
+
+    SECTION("Кэшированный хэш")
+    {
+        Triple_signal::Triple_vector left(signals);
+        Triple_signal::Triple_vector right(signals);
+        REQUIRE(left.get_hash() == right.get_hash());
+        REQUIRE(left == right);
+        REQUIRE(std::hash<Triple_signal::Triple_vector>()(left) == left.get_hash());
+
+        uint64_t hash = right.get_hash();
+        right[499] = Triple_signal::Triple_signal('X');
+        right[499] = Triple_signal::Triple_signal(signals[499]);
+        REQUIRE(right.get_hash() == hash);
+
+        right[0] = Triple_signal::Triple_signal(signals[0] == '1' ? '0' : '1');
+        REQUIRE(right.get_hash() != hash);
+        REQUIRE(left != right);
+
+        REQUIRE(Triple_signal::Triple_vector("01X").get_hash() == Triple_signal::Triple_vector("01X").get_hash());
+        REQUIRE(Triple_signal::Triple_vector("01X").get_hash() != Triple_signal::Triple_vector("01X0").get_hash());
+    }
+
+    SECTION("Таблица интернирования")
+    {
+        Triple_signal::Triple_intern_table table;
+
+        Triple_signal::Triple_vector first = table.intern(Triple_signal::Triple_vector(signals));
+        Triple_signal::Triple_vector second = table.intern(Triple_signal::Triple_vector(signals));
+        Triple_signal::Triple_vector other = table.intern(Triple_signal::Triple_vector(make_signals(500, 32)));
+
+        REQUIRE(table.get_size() == 2);
+        REQUIRE(first.get_known() == second.get_known());
+        REQUIRE(first.get_use_count() == 3);
+        REQUIRE(first != other);
+
+        other = Triple_signal::Triple_vector();
+        REQUIRE(table.collect() == 1);
+        REQUIRE(table.get_size() == 1);
+        REQUIRE(table.intern(first).get_known() == first.get_known());
+
+        table.clear();
+        REQUIRE(first.get_use_count() == 2);
+    }
+}
+
+TEST_CASE("Дописывание в конец вектора")
+{
+    SECTION("Посигнальное дописывание")
+    {
+        std::string signals = make_signals(3000, 41);
+        Triple_signal::Triple_vector vector;
+        size_t reallocations = 0;
+        const uint64_t *planes = vector.get_known();
+        for (char signal : signals)
+        {
+            vector.push_back(Triple_signal::Triple_signal(signal));
+            if (vector.get_known() != planes)
+            {
+                planes = vector.get_known();
+                reallocations++;
+            }
+        }
+
+        REQUIRE(vector.get_signals() == signals);
+        REQUIRE(vector.get_capacity() >= vector.get_size());
+        REQUIRE(reallocations <= 8);
+        REQUIRE(vector == Triple_signal::Triple_vector(signals));
+    }
+
+    SECTION("Дописывание выражений и самого себя")
+    {
+        std::string left = make_signals(70, 42);
+        std::string right = make_signals(130, 43);
+        Triple_signal::Triple_vector vector(left);
+        Triple_signal::Triple_vector other(right);
+
+        vector += other;
+        REQUIRE(vector.get_signals() == left + right);
+
+        vector.append(~other[{5, 9}]);
+        std::string inverted;
+        for (size_t i = 5; i <= 9; i++)
+            inverted += expected_not(right[i]);
+        REQUIRE(vector.get_signals() == left + right + inverted);
+
+        std::string before = vector.get_signals();
+        vector += vector;
+        REQUIRE(vector.get_signals() == before + before);
+
+        vector += vector[{1, 3}];
+        REQUIRE(vector.get_signals() == before + before + before.substr(1, 3));
+
+        vector += Triple_signal::Triple_signal('1');
+        REQUIRE(vector.get_signals().back() == '1');
+    }
+
+    SECTION("Емкость и копирование при записи")
+    {
+        Triple_signal::Triple_vector vector("01");
+        vector.reserve(1000);
+        REQUIRE(vector.get_capacity() >= 1000);
+        REQUIRE(vector.get_signals() == "01");
+
+        Triple_signal::Triple_vector copy = vector;
+        const uint64_t *planes = vector.get_known();
+        copy.push_back(Triple_signal::Triple_signal('X'));
+        REQUIRE(vector.get_signals() == "01");
+        REQUIRE(copy.get_signals() == "01X");
+        REQUIRE(vector.get_known() == planes);
+
+        vector.push_back(Triple_signal::Triple_signal('1'));
+        REQUIRE(vector.get_known() == planes);
+        REQUIRE(vector == Triple_signal::Triple_vector("011"));
+
+        vector.shrink_to_fit();
+        REQUIRE(vector.get_capacity() < 1000);
+        REQUIRE(vector.get_signals() == "011");
+        REQUIRE(vector.get_hash() == Triple_signal::Triple_vector("011").get_hash());
+    }
+}
+
+TEST_CASE("Вектор фиксированной ширины")
+{
+    using Triple_signal::Triple_vector_fixed;
+
+    constexpr Triple_vector_fixed bus_1("01X1");
+    constexpr Triple_vector_fixed bus_2("0X11");
+    static_assert(bus_1.get_size() == 4);
+    static_assert((bus_1 & bus_2) == Triple_vector_fixed<4>("0XX1"));
+    static_assert((bus_1 | bus_2) == Triple_vector_fixed<4>("0111"));
+    static_assert(~bus_1 == Triple_vector_fixed<4>("10X0"));
+    static_assert(!bus_1.is_known() && Triple_vector_fixed<3>("101").is_known());
+    static_assert(Triple_vector_fixed<8>().get_signal(7) == Triple_signal::UNKNOWN);
+    static_assert(sizeof(Triple_vector_fixed<64>) == 2 * sizeof(uint64_t));
+
+    SECTION("Операции над широкими шинами")
+    {
+        std::string signals_1 = make_signals(130, 51);
+        std::string signals_2 = make_signals(130, 52);
+        Triple_vector_fixed<130> left(signals_1);
+        Triple_vector_fixed<130> right(signals_2);
+
+        std::string expected(130, 'X');
+        for (size_t i = 0; i < 130; i++)
+            expected[i] = expected_not(expected_or(expected_and(signals_1[i], signals_2[i]), signals_2[i]));
+        REQUIRE((~((left & right) | right)).get_signals() == expected);
+        REQUIRE(left[129] == Triple_signal::Triple_signal(signals_1[129]));
+        REQUIRE_THROWS_AS(left[130], std::out_of_range);
+        REQUIRE_THROWS_AS(Triple_vector_fixed<130>(std::string_view("01")), std::invalid_argument);
+        REQUIRE_THROWS_AS(Triple_vector_fixed<2>(std::string_view("0a")), std::invalid_argument);
+    }
+
+    SECTION("Совместимость с Triple_vector")
+    {
+        std::string signals = make_signals(100, 53);
+        Triple_vector_fixed<100> fixed(signals);
+        Triple_signal::Triple_vector dynamic(signals);
+
+        Triple_signal::Triple_vector converted = fixed;
+        REQUIRE(converted == dynamic);
+        REQUIRE(Triple_vector_fixed<100>(dynamic) == fixed);
+        REQUIRE_THROWS_AS(Triple_vector_fixed<99>(dynamic), std::invalid_argument);
+
+        REQUIRE(Triple_signal::Triple_vector(fixed & dynamic) == Triple_signal::Triple_vector(dynamic & dynamic));
+        REQUIRE(Triple_signal::Triple_vector(dynamic + fixed).get_signals() == signals + signals);
+        REQUIRE(fixed == dynamic.view());
+
+        std::ostringstream out;
+        out << Triple_vector_fixed("1x0");
+        REQUIRE(out.str() == "1X0");
+    }
+}
+
+TEST_CASE("Свертки и подсчет сигналов")
+{
+    using Triple_signal::Triple_vector;
+
+    SECTION("Свертки")
+    {
+        REQUIRE(Triple_signal::and_reduce(Triple_vector("111")) == Triple_signal::Triple_signal('1'));
+        REQUIRE(Triple_signal::and_reduce(Triple_vector("1X1")) == Triple_signal::Triple_signal('X'));
+        REQUIRE(Triple_signal::and_reduce(Triple_vector("1X0")) == Triple_signal::Triple_signal('0'));
+        REQUIRE(Triple_signal::or_reduce(Triple_vector("000")) == Triple_signal::Triple_signal('0'));
+        REQUIRE(Triple_signal::or_reduce(Triple_vector("0X0")) == Triple_signal::Triple_signal('X'));
+        REQUIRE(Triple_signal::or_reduce(Triple_vector("0X1")) == Triple_signal::Triple_signal('1'));
+        REQUIRE(Triple_signal::xor_reduce(Triple_vector("1101")) == Triple_signal::Triple_signal('1'));
+        REQUIRE(Triple_signal::xor_reduce(Triple_vector("1001")) == Triple_signal::Triple_signal('0'));
+        REQUIRE(Triple_signal::xor_reduce(Triple_vector("10X1")) == Triple_signal::Triple_signal('X'));
+
+        Triple_vector empty;
+        REQUIRE(Triple_signal::and_reduce(empty) == Triple_signal::Triple_signal('1'));
+        REQUIRE(Triple_signal::or_reduce(empty) == Triple_signal::Triple_signal('0'));
+        REQUIRE(Triple_signal::xor_reduce(empty) == Triple_signal::Triple_signal('0'));
+        REQUIRE(Triple_signal::first_unknown(empty) == 0);
+
+        // Неопределенность за границей 64 сигналов и в хвосте последнего слова
+        std::string ones(200, '1');
+        REQUIRE(Triple_signal::and_reduce(Triple_vector(ones)) == Triple_signal::Triple_signal('1'));
+        ones[150] = 'X';
+        REQUIRE(Triple_signal::and_reduce(Triple_vector(ones)) == Triple_signal::Triple_signal('X'));
+        REQUIRE(Triple_signal::first_unknown(Triple_vector(ones)) == 150);
+        REQUIRE(Triple_signal::first_unknown(Triple_vector(ones)[{151, 199}]) == 49);
+        REQUIRE(Triple_signal::and_reduce(Triple_vector(ones)[{0, 149}]) == Triple_signal::Triple_signal('1'));
+    }
+
+    SECTION("Подсчет на случайных векторах")
+    {
+        for (size_t size : {1, 63, 64, 65, 1000, 100000})
+        {
+            std::string signals = make_signals(size, 60 + size);
+            Triple_vector vector(signals);
+
+            size_t zeros = std::count(signals.begin(), signals.end(), '0');
+            size_t ones = std::count(signals.begin(), signals.end(), '1');
+            REQUIRE(Triple_signal::count(vector, Triple_signal::ZERO) == zeros);
+            REQUIRE(Triple_signal::count(vector, Triple_signal::ONE) == ones);
+            REQUIRE(Triple_signal::count(vector, Triple_signal::UNKNOWN) == size - zeros - ones);
+
+            size_t unknown = signals.find('X');
+            REQUIRE(Triple_signal::first_unknown(vector) == (unknown == std::string::npos ? size : unknown));
+            REQUIRE(Triple_signal::count(~vector, Triple_signal::ONE) == zeros);
+        }
+    }
+}
+
+TEST_CASE("Симуляция на множестве шаблонов")
+{
+    using Triple_signal::Gate_type;
+    using Triple_signal::Triple_vector;
+
+    SECTION("Транспонирование")
+    {
+        std::vector<Triple_vector> rows;
+        for (size_t i = 0; i < 130; i++)
+            rows.emplace_back(make_signals(70, 70 + i));
+
+        std::vector<Triple_vector> columns = Triple_signal::transpose_signals(rows, 70);
+        REQUIRE(columns.size() == 70);
+        REQUIRE(columns[69].get_size() == 130);
+        REQUIRE(columns[5][129] == rows[129][5]);
+        REQUIRE(Triple_signal::transpose_signals(columns, 130) == rows);
+        REQUIRE_THROWS_AS(Triple_signal::transpose_signals(rows, 71), std::invalid_argument);
+    }
+
+    SECTION("Полный сумматор на всех троичных входах")
+    {
+        // sum = a ^ b ^ c через И/ИЛИ/НЕ, carry = ab | c(a | b)
+        std::vector<Triple_vector> stimuli;
+        for (char a : std::string("01X"))
+            for (char b : std::string("01X"))
+                for (char c : std::string("01X"))
+                    stimuli.emplace_back(std::string{a, b, c});
+
+        REQUIRE_THROWS_AS(Triple_signal::Batch_simulator(size_t(1) << 32), std::invalid_argument);
+        Triple_signal::Batch_simulator simulator(stimuli.size());
+        size_t a = simulator.add_input();
+        size_t b = simulator.add_input();
+        size_t c = simulator.add_input();
+
+        auto make_xor = [&](size_t x, size_t y)
+        {
+            size_t any = simulator.add_gate(Gate_type::OR, {x, y});
+            size_t both = simulator.add_gate(Gate_type::AND, {x, y});
+            size_t not_both = simulator.add_gate(Gate_type::NOT, {both});
+            return simulator.add_gate(Gate_type::AND, {any, not_both});
+        };
+        size_t sum = make_xor(make_xor(a, b), c);
+        size_t a_and_b = simulator.add_gate(Gate_type::AND, {a, b});
+        size_t a_or_b = simulator.add_gate(Gate_type::OR, {a, b});
+        size_t carry = simulator.add_gate(Gate_type::OR, {a_and_b, simulator.add_gate(Gate_type::AND, {c, a_or_b})});
+
+        simulator.set_patterns(stimuli);
+        simulator.evaluate();
+
+        std::vector<Triple_vector> responses = simulator.get_responses({sum, carry});
+        REQUIRE(responses.size() == 27);
+        for (size_t pattern = 0; pattern < stimuli.size(); pattern++)
+        {
+            Triple_signal::Triple_signal x = stimuli[pattern][0];
+            Triple_signal::Triple_signal y = stimuli[pattern][1];
+            Triple_signal::Triple_signal z = stimuli[pattern][2];
+            auto signal_xor = [](const Triple_signal::Triple_signal &p, const Triple_signal::Triple_signal &q)
+            {
+                return (p || q) && !(p && q);
+            };
+
+            REQUIRE(responses[pattern][0] == signal_xor(signal_xor(x, y), z));
+            REQUIRE(responses[pattern][1] == ((x && y) || (z && (x || y))));
+            REQUIRE(simulator.get_response(pattern, {sum, carry}) == responses[pattern]);
+        }
+        REQUIRE(simulator.get_lanes(carry).get_size() == 27);
+
+        REQUIRE_THROWS_AS(simulator.set_patterns({Triple_vector("010")}), std::invalid_argument);
+        REQUIRE_THROWS_AS(simulator.get_response(27, {sum}), std::out_of_range);
+    }
+}
+
+TEST_CASE("Ввод и вывод без промежуточных строк")
+{
+    using Triple_signal::Triple_vector;
+
+    SECTION("to_chars и from_chars для сигнала")
+    {
+        char buffer[1];
+        Triple_signal::Triple_signal signal('1');
+        REQUIRE(Triple_signal::to_chars(buffer, buffer + 1, signal).ptr == buffer + 1);
+        REQUIRE(buffer[0] == '1');
+        REQUIRE(Triple_signal::to_chars(buffer, buffer, signal).ec == std::errc::value_too_large);
+
+        std::string_view text = "UNKNOWN0x2";
+        auto result = Triple_signal::from_chars(text.data(), text.data() + text.size(), signal);
+        REQUIRE(result.ptr == text.data() + 7);
+        REQUIRE(signal.get_signal() == Triple_signal::UNKNOWN);
+
+        result = Triple_signal::from_chars(result.ptr, text.data() + text.size(), signal);
+        REQUIRE(signal.get_signal() == Triple_signal::ZERO);
+        result = Triple_signal::from_chars(result.ptr, text.data() + text.size(), signal);
+        REQUIRE(signal.get_signal() == Triple_signal::UNKNOWN);
+
+        const char *broken = result.ptr;
+        result = Triple_signal::from_chars(broken, text.data() + text.size(), signal);
+        REQUIRE(result.ec == std::errc::invalid_argument);
+        REQUIRE(result.ptr == broken);
+        REQUIRE(signal.get_signal() == Triple_signal::UNKNOWN);
+    }
+
+    SECTION("Поток сигналов")
+    {
+        std::stringstream input("  1 x\n0 UNKNOWNX 1");
+        Triple_signal::Triple_signal signal;
+        input >> signal;
+        REQUIRE(signal.get_signal() == Triple_signal::ONE);
+        input >> signal;
+        REQUIRE(signal.get_signal() == Triple_signal::UNKNOWN);
+        input >> signal;
+        REQUIRE(signal.get_signal() == Triple_signal::ZERO);
+
+        // Недопустимое слово дочитывается целиком, следующий сигнал читается корректно
+        REQUIRE_THROWS_AS(input >> signal, std::invalid_argument);
+        input >> signal;
+        REQUIRE(signal.get_signal() == Triple_signal::ONE);
+        REQUIRE(input.eof());
+
+        REQUIRE_THROWS_AS(input >> signal, std::invalid_argument);
+        REQUIRE(input.fail());
+    }
+
+    SECTION("to_chars и from_chars для вектора")
+    {
+        std::string signals = make_signals(5000, 16);
+        Triple_vector vector(signals);
+
+        std::string buffer(5000, ' ');
+        auto written = Triple_signal::to_chars(buffer.data(), buffer.data() + buffer.size(), vector);
+        REQUIRE(written.ec == std::errc());
+        REQUIRE(written.ptr == buffer.data() + 5000);
+        REQUIRE(buffer == signals);
+        REQUIRE(Triple_signal::to_chars(buffer.data(), buffer.data() + 4999, vector).ec == std::errc::value_too_large);
+
+        std::string_view middle = std::string_view(signals).substr(3, 100);
+        REQUIRE(Triple_signal::to_chars(buffer.data(), buffer.data() + 100, vector[{3, 102}]).ptr == buffer.data() + 100);
+        REQUIRE(buffer.substr(0, 100) == middle);
+
+        std::string text = "01xX10 tail";
+        Triple_vector parsed("1111111111");
+        const uint64_t *storage = parsed.get_known();
+        auto result = Triple_signal::from_chars(text.data(), text.data() + text.size(), parsed);
+        REQUIRE(result.ec == std::errc());
+        REQUIRE(result.ptr == text.data() + 6);
+        REQUIRE(parsed.get_signals() == "01XX10");
+        REQUIRE(parsed.get_known() == storage);
+
+        result = Triple_signal::from_chars(result.ptr, text.data() + text.size(), parsed);
+        REQUIRE(result.ec == std::errc::invalid_argument);
+        REQUIRE(parsed.get_signals() == "01XX10");
+
+        for (size_t position : {64, 4100, 4160, 4999})
+        {
+            std::string broken = signals;
+            broken[position] = ' ';
+            result = Triple_signal::from_chars(broken.data(), broken.data() + broken.size(), parsed);
+            REQUIRE(result.ptr == broken.data() + position);
+            REQUIRE(parsed.get_signals() == signals.substr(0, position));
+            REQUIRE(parsed == Triple_vector(signals.substr(0, position)));
+        }
+
+        REQUIRE(Triple_signal::from_chars(text.data(), text.data() + 6, parsed).ec == std::errc());
+        Triple_vector shared = parsed;
+        REQUIRE(Triple_signal::from_chars(text.data(), text.data() + 2, parsed).ec == std::errc());
+        REQUIRE(parsed.get_signals() == "01");
+        REQUIRE(shared.get_signals() == "01XX10");
+    }
+
+    SECTION("Поток векторов")
+    {
+        std::string long_signals = make_signals(10000, 17);
+        std::stringstream input("\t101 " + long_signals + "\r\n0x 1");
+
+        Triple_vector vector;
+        input >> vector;
+        REQUIRE(vector.get_signals() == "101");
+        input >> vector;
+        REQUIRE(vector.get_signals() == long_signals);
+
+        const uint64_t *storage = vector.get_known();
+        size_t capacity = vector.get_capacity();
+        input >> vector;
+        REQUIRE(vector.get_signals() == "0X");
+        if (capacity > Triple_vector::inline_bits)
+        {
+            REQUIRE(vector.get_known() == storage);
+            REQUIRE(vector == Triple_vector("0X"));
+        }
+
+        input >> std::setw(0) >> vector;
+        REQUIRE(vector.get_signals() == "1");
+        REQUIRE(input.eof());
+
+        std::stringstream limited("10101");
+        limited >> std::setw(3) >> vector;
+        REQUIRE(vector.get_signals() == "101");
+        limited >> vector;
+        REQUIRE(vector.get_signals() == "01");
+
+        std::stringstream broken(long_signals + "2" + long_signals + " 11");
+        REQUIRE_THROWS_AS(broken >> vector, std::invalid_argument);
+        REQUIRE(vector.get_size() == 0);
+        broken >> vector;
+        REQUIRE(vector.get_signals() == "11");
+    }
+
+    SECTION("Вывод в поток")
+    {
+        Triple_vector vector("01X");
+        std::ostringstream out;
+        out << std::setw(6) << vector << '|' << std::left << std::setfill('_') << std::setw(5) << vector << '|' << vector;
+        REQUIRE(out.str() == "   01X|01X__|01X");
+
+        std::string long_signals = make_signals(9000, 18);
+        Triple_vector long_vector(long_signals);
+        std::ostringstream long_out;
+        long_out << long_vector << ' ' << long_vector[{1, 8998}] << ' ' << ~long_vector;
+        REQUIRE(long_out.str() == long_signals + " " + long_signals.substr(1, 8998) + " " + Triple_vector(~long_vector).get_signals());
+
+        std::ostringstream fixed_out;
+        fixed_out << Triple_signal::Triple_vector_fixed("1X0");
+        REQUIRE(fixed_out.str() == "1X0");
+    }
+
+#ifdef __cpp_lib_format
+    SECTION("std::format")
+    {
+        Triple_vector vector("01X");
+        Triple_signal::Triple_signal signal('1');
+        REQUIRE(std::format("{} {:>2} {} {}", vector, signal, ~vector, vector[{1, 2}]) == "01X  1 10X 1X");
+    }
+#endif
+}
+
+TEST_CASE("Вектор, отображенный из файла")
+{
+    using Triple_signal::Map_mode;
+    using Triple_signal::Triple_mapped_vector;
+    using Triple_signal::Triple_vector;
+
+    std::string first_signals = make_signals(70, 20);
+    std::string second_signals = make_signals(3000, 21);
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "triple_mapped_test.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        Triple_signal::Waveform_binary_writer writer(file);
+        writer.write(Triple_vector(first_signals));
+        writer.write(Triple_vector(second_signals));
+    }
+
+    SECTION("Только чтение")
+    {
+        Triple_mapped_vector mapped(path.string(), Map_mode::READ_ONLY, 1);
+        REQUIRE(mapped.get_size() == 3000);
+        REQUIRE(mapped.view().get_signals() == second_signals);
+        REQUIRE(mapped[2999] == Triple_signal::Triple_signal(second_signals[2999]));
+
+        Triple_vector other(make_signals(3000, 22));
+        mapped.advise(true);
+        REQUIRE(Triple_vector(mapped & other) == Triple_vector(Triple_vector(second_signals) & other));
+        REQUIRE(Triple_vector(~mapped + other[{0, 9}]).get_size() == 3010);
+        REQUIRE(Triple_signal::count(mapped, Triple_signal::ONE) ==
+                size_t(std::count(second_signals.begin(), second_signals.end(), '1')));
+
+        Triple_mapped_vector first(path.string());
+        REQUIRE(first.view().get_signals() == first_signals);
+
+        REQUIRE_THROWS_AS(mapped.set_signal(0, Triple_signal::Triple_signal('1')), std::logic_error);
+        REQUIRE_THROWS_AS(mapped[3000], std::out_of_range);
+
+        Triple_mapped_vector moved = std::move(mapped);
+        REQUIRE(moved.get_size() == 3000);
+        REQUIRE(mapped.get_size() == 0);
+    }
+
+    SECTION("Копирование при записи")
+    {
+        Triple_mapped_vector mapped(path.string(), Map_mode::COPY_ON_WRITE, 1);
+        Triple_mapped_vector shared(path.string(), Map_mode::READ_ONLY, 1);
+
+        mapped.set_signal(0, Triple_signal::Triple_signal('X'));
+        mapped.set_signal(2999, Triple_signal::Triple_signal('1'));
+        REQUIRE(mapped[0].get_signal() == Triple_signal::UNKNOWN);
+        REQUIRE(mapped[2999].get_signal() == Triple_signal::ONE);
+
+        REQUIRE(shared.view().get_signals() == second_signals);
+        Triple_mapped_vector reopened(path.string(), Map_mode::READ_ONLY, 1);
+        REQUIRE(reopened.view().get_signals() == second_signals);
+    }
+
+    SECTION("Ошибки")
+    {
+        REQUIRE_THROWS_AS(Triple_mapped_vector(path.string(), Map_mode::READ_ONLY, 2), std::out_of_range);
+
+        // value установлен там, где known сброшен
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::app);
+            uint64_t record[3] = {2, 0, 1};
+            file.write(reinterpret_cast<const char *>(record), sizeof(record));
+        }
+        REQUIRE_THROWS_AS(Triple_mapped_vector(path.string(), Map_mode::READ_ONLY, 2), std::runtime_error);
+        REQUIRE_THROWS_AS(Triple_mapped_vector(path.string(), Map_mode::COPY_ON_WRITE, 2), std::runtime_error);
+        REQUIRE(Triple_mapped_vector(path.string(), Map_mode::READ_ONLY, 1).get_size() == 3000);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3 * sizeof(uint64_t));
+
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+        REQUIRE_THROWS_AS(Triple_mapped_vector(path.string(), Map_mode::READ_ONLY, 1), std::runtime_error);
+        REQUIRE(Triple_mapped_vector(path.string()).get_size() == 70);
+    }
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(Triple_mapped_vector(path.string()), std::runtime_error);
+}
+
+TEST_CASE("Троичные диаграммы решений")
+{
+    using Triple_signal::Bdd;
+    using Triple_signal::Triple_vector;
+
+    Triple_signal::Bdd_manager manager;
+    Bdd a = manager.variable(0);
+    Bdd b = manager.variable(1);
+    Bdd c = manager.variable(2);
+
+    SECTION("Эквивалентность формул")
+    {
+        REQUIRE((!(a && b)) == (!a || !b));
+        REQUIRE((a && (b || c)) == ((a && b) || (a && c)));
+        REQUIRE((!!a) == a);
+        REQUIRE((a && b) != (a || b));
+        REQUIRE((a || !a).get_constant() == Triple_signal::Triple_signal('1'));
+        REQUIRE(manager.get_variable_count() == 3);
+    }
+
+    SECTION("Листья X и вычисление с неопределенными входами")
+    {
+        Bdd x = manager.constant(Triple_signal::Triple_signal('X'));
+        Bdd masked = a && x;
+        REQUIRE(masked.evaluate(Triple_vector("0")).get_signal() == Triple_signal::ZERO);
+        REQUIRE(masked.evaluate(Triple_vector("1")).get_signal() == Triple_signal::UNKNOWN);
+        REQUIRE((x || !x).evaluate(Triple_vector("0")).get_signal() == Triple_signal::UNKNOWN);
+
+        // Симуляция теряет определенность на a || !a, диаграмма - нет
+        Triple_signal::Triple_signal unknown('X');
+        REQUIRE((unknown || !unknown).get_signal() == Triple_signal::UNKNOWN);
+        REQUIRE((a || !a).evaluate(Triple_vector("X")).get_signal() == Triple_signal::ONE);
+
+        Bdd mux = (a && b) || (!a && c);
+        REQUIRE(mux.evaluate(Triple_vector("X11")).get_signal() == Triple_signal::ONE);
+        REQUIRE(mux.evaluate(Triple_vector("X10")).get_signal() == Triple_signal::UNKNOWN);
+        REQUIRE_THROWS_AS(mux.evaluate(Triple_vector("01")), std::out_of_range);
+    }
+
+    SECTION("Сравнение с перебором")
+    {
+        auto formula = [](auto p, auto q, auto r, auto s)
+        {
+            return (p && !(q || r)) || (!p && (r || s)) || (q && s && !r);
+        };
+        Bdd d = manager.variable(3);
+        Bdd function = formula(a, b, c, d);
+
+        for (int code = 0; code < 81; code++)
+        {
+            std::string inputs;
+            for (int i = 0, rest = code; i < 4; i++, rest /= 3)
+                inputs += "01X"[rest % 3];
+
+            const Triple_vector vector(inputs);
+            Triple_signal::Signal symbolic = function.evaluate(vector).get_signal();
+            Triple_signal::Signal simulated = formula(vector[0], vector[1], vector[2], vector[3]).get_signal();
+            if (simulated != Triple_signal::UNKNOWN)
+                REQUIRE(symbolic == simulated);
+            if (inputs.find('X') == std::string::npos)
+                REQUIRE(symbolic != Triple_signal::UNKNOWN);
+        }
+    }
+
+    SECTION("Размер диаграммы четности и сборка мусора")
+    {
+        const uint32_t width = 24;
+        Bdd parity = manager.constant(Triple_signal::Triple_signal('0'));
+        for (uint32_t i = 0; i < width; i++)
+        {
+            Bdd variable = manager.variable(i);
+            parity = (parity && !variable) || (!parity && variable);
+        }
+
+        // 2^24 наборов, но 2 * 24 - 1 внутренних узлов и 2 листа
+        REQUIRE(parity.get_size() == 2 * width + 1);
+        Triple_vector inputs(std::string(width, '1'));
+        REQUIRE(parity.evaluate(inputs).get_signal() == Triple_signal::ZERO);
+        inputs[5] = Triple_signal::Triple_signal('0');
+        REQUIRE(parity.evaluate(inputs).get_signal() == Triple_signal::ONE);
+        inputs[7] = Triple_signal::Triple_signal('X');
+        REQUIRE(parity.evaluate(inputs).get_signal() == Triple_signal::UNKNOWN);
+
+        size_t before = manager.get_node_count();
+        size_t freed = manager.collect_garbage();
+        REQUIRE(freed > 0);
+        REQUIRE(manager.get_node_count() == before - freed);
+        REQUIRE(parity.get_size() == 2 * width + 1);
+        REQUIRE(parity.evaluate(inputs).get_signal() == Triple_signal::UNKNOWN);
+        REQUIRE(manager.collect_garbage() == 0);
+
+        Bdd rebuilt = manager.constant(Triple_signal::Triple_signal('0'));
+        for (uint32_t i = 0; i < width; i++)
+            rebuilt = (rebuilt || manager.variable(i)) && !(rebuilt && manager.variable(i));
+        REQUIRE(rebuilt == parity);
+    }
+
+    SECTION("Автоматическая сборка мусора")
+    {
+        Triple_signal::Bdd_manager small(64, 256);
+        Bdd x = small.variable(0);
+        Bdd kept = x;
+        for (uint32_t i = 1; i < 200; i++)
+            kept = kept && (small.variable(i) || !x);
+        REQUIRE(small.get_node_count() < 1024);
+        REQUIRE(kept.evaluate(Triple_vector(std::string(200, '1'))).get_signal() == Triple_signal::ONE);
+    }
+
+    SECTION("Ошибки")
+    {
+        Triple_signal::Bdd_manager other;
+        REQUIRE_THROWS_AS(a && other.variable(0), std::invalid_argument);
+        REQUIRE_THROWS_AS(a.get_constant(), std::logic_error);
+        REQUIRE_THROWS_AS(Bdd().is_constant(), std::logic_error);
+        REQUIRE(Bdd() == Bdd());
+    }
+}
+
+TEST_CASE("Шина с атомарной записью")
+{
+    using Triple_signal::Triple_atomic_vector;
+    using Triple_signal::Triple_vector;
+
+    SECTION("Операции одного потока")
+    {
+        std::string signals = make_signals(100, 23);
+        Triple_atomic_vector bus((Triple_vector(signals)));
+        REQUIRE(bus.get_size() == 100);
+        REQUIRE(bus.snapshot().get_signals() == signals);
+
+        Triple_vector reference(signals);
+        Triple_vector driver(make_signals(40, 24));
+        bus.resolve_and(30, driver);
+        reference = reference[{0, 29}] + (reference[{30, 69}] & driver) + reference[{70, 99}];
+        REQUIRE(bus.snapshot() == reference);
+
+        bus.resolve_or(60, driver);
+        reference = reference[{0, 59}] + (reference[{60, 99}] | driver);
+        REQUIRE(bus.snapshot() == reference);
+
+        bus.store(1, driver[{0, 9}]);
+        reference = reference[{0, 0}] + driver[{0, 9}] + reference[{11, 99}];
+        REQUIRE(bus.snapshot() == reference);
+
+        bus.set(99, Triple_signal::Triple_signal('1'));
+        bus.resolve_and(99, Triple_signal::Triple_signal('X'));
+        REQUIRE(bus.get(99).get_signal() == Triple_signal::UNKNOWN);
+        bus.resolve_or(98, Triple_signal::Triple_signal('1'));
+        REQUIRE(bus.get(98).get_signal() == Triple_signal::ONE);
+
+        Triple_atomic_vector known_bus((Triple_vector(std::string(70, '0'))));
+        REQUIRE(known_bus.is_known());
+        known_bus.mark_unknown(31, 2);
+        REQUIRE(!known_bus.is_known());
+        REQUIRE(known_bus.snapshot().get_signals() == std::string(31, '0') + "XX" + std::string(37, '0'));
+        known_bus.store(31, Triple_vector("01"));
+        REQUIRE(known_bus.is_known());
+
+        REQUIRE_THROWS_AS(bus.get(100), std::out_of_range);
+        REQUIRE_THROWS_AS(bus.store(95, driver), std::out_of_range);
+        REQUIRE_THROWS_AS(bus.mark_unknown(90, 11), std::out_of_range);
+        REQUIRE(Triple_atomic_vector(0).is_known());
+    }
+
+    SECTION("Одновременная запись из нескольких потоков")
+    {
+        const size_t width = 1000;
+        const size_t threads = 4;
+        Triple_atomic_vector bus(width);
+
+        // Каждый поток выставляет в 1 свои сигналы (с шагом threads), все вместе - сигналы общего края
+        std::vector<std::thread> writers;
+        for (size_t thread = 0; thread < threads; thread++)
+        {
+            writers.emplace_back([&bus, thread]()
+                                 {
+                for (size_t index = thread; index < width; index += threads)
+                    bus.set(index, Triple_signal::Triple_signal('0'));
+                for (size_t index = thread; index < width; index += threads)
+                    bus.resolve_or(index, Triple_signal::Triple_signal('1'));
+                for (int round = 0; round < 100; round++)
+                    bus.resolve_and(width - 1, Triple_signal::Triple_signal('1')); });
+        }
+        for (std::thread &writer : writers)
+            writer.join();
+
+        REQUIRE(bus.snapshot().get_signals() == std::string(width, '1'));
+        REQUIRE(bus.is_known());
+    }
+
+    SECTION("Согласованные снимки")
+    {
+        const size_t width = 200;
+        Triple_atomic_vector bus((Triple_vector(std::string(width, '0'))));
+        Triple_vector zeros(std::string(width, '0'));
+        Triple_vector ones(std::string(width, '1'));
+
+        std::atomic<bool> stop{false};
+        std::thread writer([&]()
+                           {
+            for (int round = 0; round < 2000; round++)
+            {
+                bus.store(0, round % 2 ? zeros : ones);
+                if (round % 3 == 0)
+                    bus.mark_unknown(0, width);
+            }
+            stop = true; });
+
+        bool consistent = true;
+        size_t snapshots = 0;
+        while (!stop || snapshots == 0)
+        {
+            std::string signals = bus.snapshot().get_signals();
+            consistent &= signals.find_first_not_of(signals[0]) == std::string::npos;
+            snapshots++;
+        }
+        writer.join();
+        REQUIRE(consistent);
+    }
+
+    SECTION("Снимки при непрерывной записи в несколько полос")
+    {
+        const size_t stripe = Triple_atomic_vector::stripe_words * Triple_atomic_vector::word_signals;
+        const size_t threads = 3;
+        Triple_atomic_vector bus((Triple_vector(std::string((threads + 1) * stripe, '0'))));
+        Triple_vector zeros(std::string(stripe, '0'));
+        Triple_vector ones(std::string(stripe, '1'));
+
+        // Каждый писатель перезаписывает свой участок на границе двух полос и не останавливается,
+        // пока читатель не сделает все снимки
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> writers;
+        for (size_t thread = 0; thread < threads; thread++)
+        {
+            writers.emplace_back([&, thread]()
+                                 {
+                for (size_t round = 0; !stop; round++)
+                    bus.store(thread * stripe + stripe / 2, round % 2 ? zeros : ones); });
+        }
+
+        bool consistent = true;
+        for (int snapshot = 0; snapshot < 200; snapshot++)
+        {
+            std::string signals = bus.snapshot().get_signals();
+            for (size_t thread = 0; thread < threads; thread++)
+            {
+                std::string part = signals.substr(thread * stripe + stripe / 2, stripe);
+                consistent &= part.find_first_not_of(part[0]) == std::string::npos;
+            }
+            consistent &= bus.is_known();
+        }
+        stop = true;
+        for (std::thread &writer : writers)
+            writer.join();
+        REQUIRE(consistent);
+    }
+}
+
+namespace
+{
+    // Ресурс, считающий обращения к куче
+    class Counting_resource : public std::pmr::memory_resource
+    {
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+
+    protected:
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            allocations++;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override
+        {
+            deallocations++;
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &resource) const noexcept override
+        {
+            return this == &resource;
+        }
+    };
+}
+
+TEST_CASE("Выделение памяти из арены такта")
+{
+    using Triple_signal::Triple_cycle_arena;
+    using Triple_signal::Triple_vector;
+
+    const size_t width = 300;
+    Triple_vector a(make_signals(width, 31));
+    Triple_vector b(make_signals(width, 32));
+    Triple_vector c(make_signals(width, 33));
+
+    SECTION("Арена")
+    {
+        Counting_resource heap;
+        Triple_cycle_arena arena(256, &heap);
+        REQUIRE(arena.get_capacity() == 0);
+
+        void *first = arena.allocate(100, 64);
+        void *second = arena.allocate(1000, 64);
+        REQUIRE(reinterpret_cast<uintptr_t>(first) % 64 == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(second) % 64 == 0);
+        REQUIRE(arena.get_allocated() == 1100);
+        REQUIRE(heap.allocations == 2);
+
+        arena.deallocate(second, 1000, 64);
+        REQUIRE(heap.deallocations == 0);
+
+        // После сброса блоки слиты в один, и тот же объем помещается без новых блоков
+        arena.reset();
+        REQUIRE(arena.get_allocated() == 0);
+        size_t capacity = arena.get_capacity();
+        size_t upstream = arena.get_upstream_allocations();
+        REQUIRE(arena.allocate(100, 64) != nullptr);
+        REQUIRE(arena.allocate(1000, 64) != nullptr);
+        REQUIRE(arena.get_upstream_allocations() == upstream);
+        REQUIRE(arena.get_capacity() == capacity);
+        REQUIRE(arena.is_equal(arena));
+        REQUIRE(!arena.is_equal(heap));
+    }
+
+    SECTION("Временные векторы такта")
+    {
+        Counting_resource heap;
+        Triple_cycle_arena arena(1024, &heap);
+        Counting_resource state_heap;
+        Triple_vector state(c, &state_heap);
+        REQUIRE(state.get_resource() == &state_heap);
+        REQUIRE(state_heap.allocations == 1);
+
+        size_t upstream = 0;
+        for (int cycle = 0; cycle < 10; cycle++)
+        {
+            {
+                Triple_vector sum(a & b, &arena);
+                Triple_vector carry(&arena);
+                carry = (a | b) & ~state;
+                sum.append(carry);
+                sum = sum[{0, width - 1}] | carry;
+                REQUIRE(sum.get_resource() == &arena);
+
+                // Копирование в состояние переиспользует его буфер
+                state = sum;
+                REQUIRE(state.get_resource() == &state_heap);
+                REQUIRE(state == sum);
+            }
+            REQUIRE(arena.get_allocated() > 0);
+            arena.reset();
+
+            if (cycle == 1)
+                upstream = arena.get_upstream_allocations();
+        }
+        REQUIRE(arena.get_upstream_allocations() == upstream);
+        REQUIRE(state_heap.allocations == 1);
+        REQUIRE(heap.deallocations == heap.allocations - 1);
+    }
+
+    SECTION("Ресурс при копировании и перемещении")
+    {
+        Triple_cycle_arena arena;
+        Triple_vector temporary(a, &arena);
+        REQUIRE(temporary.get_resource() == &arena);
+        REQUIRE(temporary == a);
+        REQUIRE(a.get_use_count() == 1);
+
+        // Копия получает ресурс по умолчанию
+        Triple_vector copy(temporary);
+        REQUIRE(copy.get_resource() == std::pmr::get_default_resource());
+        REQUIRE(copy == a);
+
+        Triple_vector shared(temporary, &arena);
+        REQUIRE(shared == temporary);
+        if (Triple_vector::inline_bits < width)
+            REQUIRE(temporary.get_use_count() == 2);
+
+        shared[0] = Triple_signal::Triple_signal('X');
+        REQUIRE(shared.get_resource() == &arena);
+        REQUIRE(temporary == a);
+
+        Triple_vector moved(std::move(shared));
+        REQUIRE(moved.get_resource() == &arena);
+
+        // Присваивание из другого ресурса копирует сигналы и сохраняет ресурс вектора
+        copy = std::move(moved);
+        REQUIRE(copy.get_resource() == std::pmr::get_default_resource());
+        REQUIRE(copy[0] == Triple_signal::Triple_signal('X'));
+        REQUIRE(copy.get_use_count() == 1);
+
+        // Из равного ресурса буфер забирается
+        Triple_vector stolen(&arena);
+        stolen = std::move(moved);
+        REQUIRE(stolen.get_resource() == &arena);
+        REQUIRE(stolen[0] == Triple_signal::Triple_signal('X'));
+        REQUIRE(moved.get_size() == 0);
+
+        Triple_vector grown(&arena);
+        for (size_t index = 0; index < width; index++)
+            grown.push_back(a[index]);
+        grown.reserve(4 * width);
+        grown.shrink_to_fit();
+        REQUIRE(grown == a);
+        REQUIRE(grown.get_resource() == &arena);
+    }
+}
@@ -1,4 +1,7 @@
 #include <iostream>
+#include <cstring>
+#include <locale>
+#include <stdexcept>
 
 #include "triple_signal.hpp"
 
@@ -82,22 +85,7 @@ namespace Triple_signal
 
     void Triple_signal::input(std::istream &in)
     {
-        std::string input;
-        in >> input;
-        if (input == "0")
-            this->set_signal(ZERO);
-        else if (input == "1")
-        {
-            this->set_signal(ONE);
-        }
-        else if (input == "UNKNOWN" || input == "x" || input == "X")
-        {
-            this->set_signal(UNKNOWN);
-        }
-        else
-        {
-            throw std::invalid_argument("invalid signal");
-        }
+        in >> *this;
     }
 
     Triple_signal Triple_signal::operator||(const Triple_signal &signal2) const
@@ -144,24 +132,89 @@ namespace Triple_signal
 
     std::istream &operator>>(std::istream &in, Triple_signal &signal)
     {
-        std::string input;
-        in >> input;
-        if (input == "0")
-            signal.set_signal(ZERO);
-        else if (input == "1")
+        // Слово читается прямо из буфера потока: в самом длинном сигнале (UNKNOWN) 7 символов,
+        // более длинное слово дочитывается до конца, но не сохраняется
+        char token[8];
+        size_t length = 0;
+
+        std::istream::sentry sentry(in);
+        if (sentry)
         {
-            signal.set_signal(ONE);
+            const std::ctype<char> &ctype = std::use_facet<std::ctype<char>>(in.getloc());
+            std::streambuf *buffer = in.rdbuf();
+            std::ios_base::iostate state = std::ios_base::goodbit;
+
+            for (int symbol = buffer->sgetc();; symbol = buffer->snextc())
+            {
+                if (std::char_traits<char>::eq_int_type(symbol, std::char_traits<char>::eof()))
+                {
+                    state |= std::ios_base::eofbit;
+                    break;
+                }
+
+                char character = std::char_traits<char>::to_char_type(symbol);
+                if (ctype.is(std::ctype_base::space, character))
+                    break;
+                if (length < sizeof(token))
+                    token[length] = character;
+                length++;
+            }
+
+            in.width(0);
+            if (length == 0)
+                state |= std::ios_base::failbit;
+            in.setstate(state);
         }
-        else if (input == "UNKNOWN" || input == "x" || input == "X")
+
+        if (length == 0 || length >= sizeof(token) ||
+            from_chars(token, token + length, signal).ptr != token + length)
+        {
+            throw std::invalid_argument("invalid signal");
+        }
+
+        return in;
+    }
+
+    std::to_chars_result to_chars(char *first, char *last, const Triple_signal &signal)
+    {
+        if (first == last)
+            return {last, std::errc::value_too_large};
+
+        *first = signal.get_signal_char();
+        return {first + 1, std::errc()};
+    }
+
+    std::from_chars_result from_chars(const char *first, const char *last, Triple_signal &signal)
+    {
+        constexpr char unknown[] = "UNKNOWN";
+        constexpr size_t unknown_length = sizeof(unknown) - 1;
+
+        if (static_cast<size_t>(last - first) >= unknown_length && std::memcmp(first, unknown, unknown_length) == 0)
         {
             signal.set_signal(UNKNOWN);
+            return {first + unknown_length, std::errc()};
         }
-        else
+
+        if (first != last)
         {
-            throw std::invalid_argument("invalid signal");
+            switch (*first)
+            {
+            case '0':
+                signal.set_signal(ZERO);
+                return {first + 1, std::errc()};
+            case '1':
+                signal.set_signal(ONE);
+                return {first + 1, std::errc()};
+            case 'x':
+            case 'X':
+                signal.set_signal(UNKNOWN);
+                return {first + 1, std::errc()};
+            default:
+                break;
+            }
         }
 
-        return in;
+        return {first, std::errc::invalid_argument};
     }
 
 }
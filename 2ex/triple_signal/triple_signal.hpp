@@ -12,6 +12,12 @@
 #ifndef TRIPLE_SIGNAL_H
 #define TRIPLE_SIGNAL_H
 
+#include <charconv>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
 namespace Triple_signal
 {
     /**
@@ -180,6 +186,47 @@ namespace Triple_signal
         friend std::istream &operator>>(std::istream &in, Triple_signal &signal);
     };
 
+    /**
+     * @brief Запись сигнала символом 0/1/X без выделения памяти
+     *
+     * @param first Начало буфера
+     * @param last Конец буфера
+     * @param signal Записываемый сигнал
+     * @return std::to_chars_result ptr - за записанным символом;
+     * ec == std::errc::value_too_large, если буфер пуст
+     */
+    std::to_chars_result to_chars(char *first, char *last, const Triple_signal &signal);
+
+    /**
+     * @brief Разбор сигнала из начала строки без выделения памяти
+     *
+     * Принимает 0/1/UNKNOWN/x/X, символы после сигнала не читаются
+     *
+     * @param first Начало строки
+     * @param last Конец строки
+     * @param signal Сигнал, изменяется только при успешном разборе
+     * @return std::from_chars_result ptr - за разобранным сигналом;
+     * ec == std::errc::invalid_argument и ptr == first, если строка не начинается с сигнала
+     */
+    std::from_chars_result from_chars(const char *first, const char *last, Triple_signal &signal);
+
 }
 
+#ifdef __cpp_lib_format
+/**
+ * @brief Форматирование сигнала через std::format
+ *
+ * Выводится 0/1/X, поддерживаются спецификаторы символа: std::format("{:>3}", signal)
+ */
+template <>
+struct std::formatter<Triple_signal::Triple_signal, char> : std::formatter<char, char>
+{
+    template <typename Context>
+    auto format(const Triple_signal::Triple_signal &signal, Context &context) const
+    {
+        return std::formatter<char, char>::format(signal.get_signal_char(), context);
+    }
+};
+#endif
+
 #endif
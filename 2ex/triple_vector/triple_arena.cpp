@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "triple_arena.hpp"
+
+namespace Triple_signal
+{
+    Triple_cycle_arena::Triple_cycle_arena(size_t initial_size, std::pmr::memory_resource *upstream)
+        : upstream(upstream), initial_size(std::max<size_t>(initial_size, block_alignment)) {}
+
+    Triple_cycle_arena::~Triple_cycle_arena()
+    {
+        release_blocks();
+    }
+
+    void Triple_cycle_arena::add_block(size_t size)
+    {
+        blocks.reserve(blocks.size() + 1);
+        char *data = static_cast<char *>(upstream->allocate(size, block_alignment));
+        blocks.push_back({data, size});
+        upstream_allocations++;
+    }
+
+    void Triple_cycle_arena::release_blocks() noexcept
+    {
+        for (const Block &block : blocks)
+            upstream->deallocate(block.data, block.size, block_alignment);
+        blocks.clear();
+    }
+
+    void *Triple_cycle_arena::do_allocate(size_t bytes, size_t alignment)
+    {
+        while (true)
+        {
+            if (current == blocks.size())
+            {
+                size_t next = blocks.empty() ? initial_size : 2 * blocks.back().size;
+                add_block(std::max(next, bytes + alignment));
+            }
+
+            const Block &block = blocks[current];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+            uintptr_t start = (base + offset + alignment - 1) & ~uintptr_t(alignment - 1);
+            if (start + bytes <= base + block.size)
+            {
+                offset = start + bytes - base;
+                allocated += bytes;
+                return reinterpret_cast<void *>(start);
+            }
+
+            current++;
+            offset = 0;
+        }
+    }
+
+    void Triple_cycle_arena::do_deallocate(void *, size_t, size_t)
+    {
+        // Память такта освобождается целиком в reset()
+    }
+
+    bool Triple_cycle_arena::do_is_equal(const std::pmr::memory_resource &resource) const noexcept
+    {
+        return this == &resource;
+    }
+
+    void Triple_cycle_arena::reset()
+    {
+        current = 0;
+        offset = 0;
+        allocated = 0;
+
+        if (blocks.size() > 1)
+        {
+            size_t total = get_capacity();
+            release_blocks();
+            add_block(total);
+        }
+    }
+
+    size_t Triple_cycle_arena::get_allocated() const
+    {
+        return allocated;
+    }
+
+    size_t Triple_cycle_arena::get_capacity() const
+    {
+        size_t total = 0;
+        for (const Block &block : blocks)
+            total += block.size;
+        return total;
+    }
+
+    size_t Triple_cycle_arena::get_upstream_allocations() const
+    {
+        return upstream_allocations;
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * @file triple_arena.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий арену памяти для временных векторов одного такта симуляции
+ * @version 0.1
+ * @date 2025-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_ARENA_H
+#define TRIPLE_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace Triple_signal
+{
+    /**
+     * @brief Монотонная арена памяти, сбрасываемая целиком в конце такта
+     *
+     * Выделение - сдвиг указателя в текущем блоке, освобождение ничего не делает,
+     * вся память такта возвращается одним вызовом reset(). Блоки берутся у вышестоящего ресурса
+     * и растут вдвое. reset() сливает блоки такта в один блок их суммарного размера,
+     * поэтому после первых тактов арена больше не обращается к вышестоящему ресурсу.
+     *
+     * Используется как ресурс памяти Triple_vector: Triple_vector temporary(&arena).
+     * Все векторы с буфером из арены должны быть уничтожены или переприсвоены до reset().
+     *
+     * Не потокобезопасна.
+     */
+    class Triple_cycle_arena : public std::pmr::memory_resource
+    {
+        struct Block
+        {
+            char *data;
+            size_t size;
+        };
+
+        static constexpr size_t block_alignment = 64;
+
+        std::pmr::memory_resource *upstream;
+        std::vector<Block> blocks;
+        size_t initial_size;
+        size_t current = 0;
+        size_t offset = 0;
+        size_t allocated = 0;
+        size_t upstream_allocations = 0;
+
+        void add_block(size_t size);
+        void release_blocks() noexcept;
+
+    protected:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &resource) const noexcept override;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * Память не выделяется до первого запроса
+         *
+         * @param initial_size Размер первого блока в байтах
+         * @param upstream Ресурс, из которого берутся блоки
+         */
+        explicit Triple_cycle_arena(size_t initial_size = 64 * 1024,
+                                    std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+        Triple_cycle_arena(const Triple_cycle_arena &) = delete;
+        Triple_cycle_arena &operator=(const Triple_cycle_arena &) = delete;
+
+        /**
+         * @brief Деструктор
+         *
+         * Возвращает все блоки вышестоящему ресурсу
+         */
+        ~Triple_cycle_arena() override;
+
+        /**
+         * @brief Конец такта: вся выделенная память снова свободна
+         *
+         * Несколько блоков сливаются в один, чтобы следующий такт уместился без новых блоков
+         */
+        void reset();
+
+        /**
+         * @brief Число байт, выданных с последнего reset()
+         *
+         * @return size_t
+         */
+        size_t get_allocated() const;
+
+        /**
+         * @brief Суммарный размер блоков арены в байтах
+         *
+         * @return size_t
+         */
+        size_t get_capacity() const;
+
+        /**
+         * @brief Число обращений к вышестоящему ресурсу за все время жизни арены
+         *
+         * @return size_t
+         */
+        size_t get_upstream_allocations() const;
+    };
+}
+
+#endif
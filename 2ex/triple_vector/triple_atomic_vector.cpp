@@ -0,0 +1,194 @@
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "triple_atomic_vector.hpp"
+
+namespace Triple_signal
+{
+    Triple_atomic_vector::Triple_atomic_vector(size_t size)
+        : size(size), words(new std::atomic<uint64_t>[word_count(size)]), stripes(new Stripe[stripe_count(size)])
+    {
+        for (size_t word = 0; word < word_count(size); word++)
+            words[word].store(0, std::memory_order_relaxed);
+    }
+
+    Triple_atomic_vector::Triple_atomic_vector(const Triple_vector &vector) : Triple_atomic_vector(vector.get_size())
+    {
+        for (size_t word = 0; word < word_count(size); word++)
+        {
+            uint64_t known, value;
+            vector.load(word * word_signals, known, value);
+
+            size_t rest = size - word * word_signals;
+            uint64_t mask = rest >= word_signals ? half_mask : (uint64_t(1) << rest) - 1;
+            words[word].store(pack(known & mask, value & mask), std::memory_order_relaxed);
+        }
+    }
+
+    void Triple_atomic_vector::check_range(size_t offset, size_t count) const
+    {
+        if (offset > size || count > size - offset)
+        {
+            throw std::out_of_range("Range [" + std::to_string(offset) + ", " + std::to_string(offset + count) +
+                                    ") out of range for vector of size " + std::to_string(size));
+        }
+    }
+
+    void Triple_atomic_vector::begin_write(size_t offset, size_t count)
+    {
+        if (count == 0)
+            return;
+
+        size_t first = offset / word_signals / stripe_words;
+        size_t last = (offset + count - 1) / word_signals / stripe_words;
+        while (true)
+        {
+            for (size_t stripe = first; stripe <= last; stripe++)
+                stripes[stripe].version.fetch_add(writer_enter);
+            if (blocking_readers.load() == 0)
+                return;
+
+            // Снимок остановил записи: снимаем отметку, ничего не записав, и ждем его
+            for (size_t stripe = first; stripe <= last; stripe++)
+                stripes[stripe].version.fetch_sub(writer_enter);
+            while (blocking_readers.load() != 0)
+                std::this_thread::yield();
+        }
+    }
+
+    void Triple_atomic_vector::end_write(size_t offset, size_t count)
+    {
+        if (count == 0)
+            return;
+
+        size_t first = offset / word_signals / stripe_words;
+        size_t last = (offset + count - 1) / word_signals / stripe_words;
+        for (size_t stripe = first; stripe <= last; stripe++)
+            stripes[stripe].version.fetch_add(writer_leave);
+    }
+
+    template <typename F>
+    void Triple_atomic_vector::read_consistent(F &&function) const
+    {
+        // Записей не было, если перед чтением ни в одной полосе нет идущих записей,
+        // а после чтения версии всех полос не изменились. Запись отмечается во всех своих
+        // полосах до первого изменения слов, поэтому частично видимая запись меняет версию
+        size_t count = stripe_count(size);
+        std::vector<uint64_t> versions(count);
+        for (size_t attempt = 0; attempt < read_attempts; attempt++)
+        {
+            bool idle = true;
+            for (size_t stripe = 0; stripe < count; stripe++)
+            {
+                versions[stripe] = stripes[stripe].version.load();
+                idle &= (versions[stripe] & writers_mask) == 0;
+            }
+            if (idle)
+            {
+                function();
+                bool unchanged = true;
+                for (size_t stripe = 0; unchanged && stripe < count; stripe++)
+                    unchanged = stripes[stripe].version.load() == versions[stripe];
+                if (unchanged)
+                    return;
+            }
+            std::this_thread::yield();
+        }
+
+        // Записи идут непрерывно: новые ждут в begin_write, идущие дописываются
+        blocking_readers.fetch_add(1);
+        for (size_t stripe = 0; stripe < count; stripe++)
+        {
+            while (stripes[stripe].version.load() & writers_mask)
+                std::this_thread::yield();
+        }
+        function();
+        blocking_readers.fetch_sub(1);
+    }
+
+    size_t Triple_atomic_vector::get_size() const
+    {
+        return size;
+    }
+
+    Triple_signal Triple_atomic_vector::get(size_t index) const
+    {
+        check_range(index, 1);
+
+        uint64_t word = words[index / word_signals].load(std::memory_order_acquire);
+        uint64_t bit = uint64_t(1) << (index % word_signals);
+        if (!(word & bit))
+            return Triple_signal(UNKNOWN);
+        return Triple_signal((word >> word_signals) & bit ? ONE : ZERO);
+    }
+
+    void Triple_atomic_vector::set(size_t index, const Triple_signal &signal)
+    {
+        store(index, Triple_single(signal));
+    }
+
+    void Triple_atomic_vector::resolve_and(size_t index, const Triple_signal &signal)
+    {
+        resolve_and(index, Triple_single(signal));
+    }
+
+    void Triple_atomic_vector::resolve_or(size_t index, const Triple_signal &signal)
+    {
+        resolve_or(index, Triple_single(signal));
+    }
+
+    void Triple_atomic_vector::mark_unknown(size_t offset, size_t count)
+    {
+        check_range(offset, count);
+
+        begin_write(offset, count);
+        for (size_t signal = offset; signal < offset + count;)
+        {
+            size_t shift = signal % word_signals;
+            size_t taken = std::min(word_signals - shift, offset + count - signal);
+            uint64_t mask = ((uint64_t(1) << taken) - 1) << shift;
+
+            words[signal / word_signals].fetch_and(~pack(mask, mask), std::memory_order_acq_rel);
+            signal += taken;
+        }
+        end_write(offset, count);
+    }
+
+    Triple_vector Triple_atomic_vector::snapshot() const
+    {
+        size_t planes = Triple_vector::word_count(size);
+        std::vector<uint64_t> known(planes);
+        std::vector<uint64_t> value(planes);
+
+        read_consistent([&]()
+                        {
+            std::fill(known.begin(), known.end(), 0);
+            std::fill(value.begin(), value.end(), 0);
+            for (size_t word = 0; word < word_count(size); word++)
+            {
+                uint64_t packed = words[word].load(std::memory_order_acquire);
+                size_t shift = word % 2 * word_signals;
+                known[word / 2] |= (packed & half_mask) << shift;
+                value[word / 2] |= (packed >> word_signals) << shift;
+            } });
+
+        return Triple_vector(Triple_vector_view(known.data(), value.data(), 0, size));
+    }
+
+    bool Triple_atomic_vector::is_known() const
+    {
+        bool result = true;
+        read_consistent([&]()
+                        {
+            result = true;
+            for (size_t word = 0; result && word < word_count(size); word++)
+            {
+                size_t rest = size - word * word_signals;
+                uint64_t mask = rest >= word_signals ? half_mask : (uint64_t(1) << rest) - 1;
+                result = (words[word].load(std::memory_order_acquire) & mask) == mask;
+            } });
+        return result;
+    }
+}
@@ -0,0 +1,311 @@
+/**
+ * @file triple_atomic_vector.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий вектор троичных сигналов для одновременной записи из нескольких потоков
+ * @version 0.1
+ * @date 2025-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_ATOMIC_VECTOR_H
+#define TRIPLE_ATOMIC_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "../triple_signal/triple_signal.hpp"
+#include "triple_expr.hpp"
+#include "triple_kernels.hpp"
+#include "triple_vector.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Общая шина, которую потоки изменяют без мьютекса
+     *
+     * Каждое атомарное слово хранит 32 сигнала: младшие 32 бита - плоскость known,
+     * старшие - плоскость value, поэтому сигнал меняется одним compare-and-swap
+     * и читатель никогда не видит known и value из разных записей.
+     * Операции записи неблокирующие (lock-free): цикл CAS по каждому затронутому слову.
+     *
+     * Запись диапазона атомарна по отдельным словам, но снимок и is_known видят ее целиком.
+     * Слова разбиты на полосы по stripe_words, у каждой полосы свой счетчик версий на отдельной
+     * кэш-линии (seqlock): запись отмечается во всех затронутых полосах, поэтому потоки,
+     * пишущие в разные полосы, не конкурируют за общий счетчик. Снимок повторяется, пока
+     * версии полос не совпадут до и после чтения, а после read_attempts неудачных попыток
+     * ненадолго останавливает новые записи, так что непрерывная запись не откладывает его бесконечно.
+     */
+    class Triple_atomic_vector
+    {
+    public:
+        /**
+         * @brief Количество сигналов в одном атомарном слове
+         *
+         */
+        static constexpr size_t word_signals = 32;
+
+        /**
+         * @brief Количество атомарных слов в одной полосе версий
+         *
+         */
+        static constexpr size_t stripe_words = 64;
+
+        /**
+         * @brief Количество попыток чтения без блокировки перед остановкой записей
+         *
+         */
+        static constexpr size_t read_attempts = 8;
+
+    private:
+        static constexpr uint64_t half_mask = (uint64_t(1) << word_signals) - 1;
+
+        /**
+         * @brief Версия полосы: младшие 32 бита - число идущих записей, старшие - число завершенных
+         *
+         */
+        struct alignas(64) Stripe
+        {
+            std::atomic<uint64_t> version{0};
+        };
+
+        static constexpr uint64_t writers_mask = (uint64_t(1) << 32) - 1;
+        static constexpr uint64_t writer_enter = 1;
+        // Одно сложение уменьшает число идущих записей и увеличивает число завершенных
+        static constexpr uint64_t writer_leave = writers_mask;
+
+        size_t size = 0;
+        std::unique_ptr<std::atomic<uint64_t>[]> words;
+        std::unique_ptr<Stripe[]> stripes;
+        alignas(64) mutable std::atomic<size_t> blocking_readers{0};
+
+        /**
+         * @brief Количество атомарных слов под size сигналов
+         *
+         */
+        static size_t word_count(size_t size)
+        {
+            return (size + word_signals - 1) / word_signals;
+        }
+
+        /**
+         * @brief Количество полос версий под size сигналов
+         *
+         */
+        static size_t stripe_count(size_t size)
+        {
+            return (word_count(size) + stripe_words - 1) / stripe_words;
+        }
+
+        void check_range(size_t offset, size_t count) const;
+
+        /**
+         * @brief Отмечает начало записи в полосах сигналов [offset, offset + count)
+         *
+         * Пока снимок остановил записи, ждет его завершения
+         */
+        void begin_write(size_t offset, size_t count);
+
+        /**
+         * @brief Отмечает завершение записи в полосах сигналов [offset, offset + count)
+         *
+         */
+        void end_write(size_t offset, size_t count);
+
+        /**
+         * @brief Применяет function(old_known, old_value, mask, known, value) -> новое слово
+         * к словам диапазона [offset, offset + operand.get_size()) через CAS
+         *
+         * known/value - сигналы operand, сдвинутые на свое место в слове, mask - затронутые биты
+         */
+        template <typename E, typename F>
+        void update(size_t offset, const Triple_expr<E> &operand, F &&function)
+        {
+            size_t count = operand.get_size();
+            check_range(offset, count);
+
+            begin_write(offset, count);
+            for (size_t signal = offset; signal < offset + count;)
+            {
+                size_t word = signal / word_signals;
+                size_t shift = signal % word_signals;
+                size_t taken = std::min(word_signals - shift, offset + count - signal);
+
+                uint64_t known, value;
+                operand.load(signal - offset, known, value);
+                uint64_t mask = ((uint64_t(1) << taken) - 1) << shift;
+                known = (known << shift) & mask;
+                value = (value << shift) & mask;
+
+                uint64_t old = words[word].load(std::memory_order_relaxed);
+                uint64_t updated;
+                do
+                {
+                    updated = function(old & half_mask, old >> word_signals, mask, known, value);
+                } while (!words[word].compare_exchange_weak(old, updated, std::memory_order_acq_rel,
+                                                            std::memory_order_relaxed));
+                signal += taken;
+            }
+            end_write(offset, count);
+        }
+
+        /**
+         * @brief Упаковывает половины known и value в одно слово
+         *
+         */
+        static uint64_t pack(uint64_t known, uint64_t value)
+        {
+            return (known & half_mask) | (value & half_mask) << word_signals;
+        }
+
+        /**
+         * @brief Повторяет function(), пока во время ее выполнения не было записей
+         *
+         * После read_attempts неудачных попыток останавливает новые записи и дожидается идущих
+         */
+        template <typename F>
+        void read_consistent(F &&function) const;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * Создает вектор из size неопределенных сигналов
+         *
+         * @param size Количество сигналов
+         */
+        explicit Triple_atomic_vector(size_t size);
+
+        /**
+         * @brief Конструктор из вектора
+         *
+         * @param vector Начальное значение
+         */
+        explicit Triple_atomic_vector(const Triple_vector &vector);
+
+        Triple_atomic_vector(const Triple_atomic_vector &) = delete;
+        Triple_atomic_vector &operator=(const Triple_atomic_vector &) = delete;
+
+        /**
+         * @brief Количество сигналов
+         *
+         * @return size_t
+         */
+        size_t get_size() const;
+
+        /**
+         * @brief Чтение сигнала одной атомарной загрузкой
+         *
+         * @param index
+         * @return Triple_signal
+         * @throw std::out_of_range индекс больше размера вектора
+         */
+        Triple_signal get(size_t index) const;
+
+        /**
+         * @brief Установка сигнала
+         *
+         * @param index
+         * @param signal
+         * @throw std::out_of_range индекс больше размера вектора
+         */
+        void set(size_t index, const Triple_signal &signal);
+
+        /**
+         * @brief Запись сигналов начиная с сигнала offset
+         *
+         * @param offset Номер первого записываемого сигнала
+         * @param signals Записываемые сигналы: вектор, представление или выражение
+         * @throw std::out_of_range диапазон выходит за размер вектора
+         */
+        template <typename E>
+        void store(size_t offset, const Triple_expr<E> &signals)
+        {
+            update(offset, signals, [](uint64_t old_known, uint64_t old_value, uint64_t mask, uint64_t known, uint64_t value)
+                   { return pack((old_known & ~mask) | known, (old_value & ~mask) | value); });
+        }
+
+        /**
+         * @brief Разрешение конфликта драйверов через И: сигнал становится signal && текущий
+         *
+         * @param index
+         * @param signal
+         * @throw std::out_of_range индекс больше размера вектора
+         */
+        void resolve_and(size_t index, const Triple_signal &signal);
+
+        /**
+         * @brief Поразрядное разрешение через И для сигналов начиная с offset
+         *
+         * Вне диапазона операнд дополняется единицами (нейтральный элемент И)
+         *
+         * @throw std::out_of_range диапазон выходит за размер вектора
+         */
+        template <typename E>
+        void resolve_and(size_t offset, const Triple_expr<E> &signals)
+        {
+            update(offset, signals, [](uint64_t old_known, uint64_t old_value, uint64_t mask, uint64_t known, uint64_t value)
+                   {
+                uint64_t result_known, result_value;
+                kernels::and_word(old_known, old_value, known | ~mask, value | ~mask, result_known, result_value);
+                return pack(result_known, result_value); });
+        }
+
+        /**
+         * @brief Разрешение конфликта драйверов через ИЛИ: сигнал становится signal || текущий
+         *
+         * @param index
+         * @param signal
+         * @throw std::out_of_range индекс больше размера вектора
+         */
+        void resolve_or(size_t index, const Triple_signal &signal);
+
+        /**
+         * @brief Поразрядное разрешение через ИЛИ для сигналов начиная с offset
+         *
+         * Вне диапазона операнд дополняется нулями (нейтральный элемент ИЛИ)
+         *
+         * @throw std::out_of_range диапазон выходит за размер вектора
+         */
+        template <typename E>
+        void resolve_or(size_t offset, const Triple_expr<E> &signals)
+        {
+            update(offset, signals, [](uint64_t old_known, uint64_t old_value, uint64_t mask, uint64_t known, uint64_t value)
+                   {
+                uint64_t result_known, result_value;
+                kernels::or_word(old_known, old_value, known | ~mask, value, result_known, result_value);
+                return pack(result_known, result_value); });
+        }
+
+        /**
+         * @brief Делает сигналы [offset, offset + count) неопределенными
+         *
+         * Одна атомарная операция fetch_and на слово, без цикла CAS
+         *
+         * @throw std::out_of_range диапазон выходит за размер вектора
+         */
+        void mark_unknown(size_t offset, size_t count = 1);
+
+        /**
+         * @brief Согласованный снимок всех сигналов
+         *
+         * Снимок отражает состояние между записями: ни одна запись диапазона не видна частично
+         *
+         * @return Triple_vector
+         */
+        Triple_vector snapshot() const;
+
+        /**
+         * @brief Проверка на определенность всех сигналов по согласованному состоянию
+         *
+         * @return true Все сигналы определенны
+         * @return false Есть хотя бы один неопределенный сигнал
+         */
+        bool is_known() const;
+    };
+}
+
+#endif
@@ -0,0 +1,477 @@
+/**
+ * @file triple_expr.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий ленивые выражения над векторами троичных сигналов
+ * @version 0.1
+ * @date 2025-10-08
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_EXPR_H
+#define TRIPLE_EXPR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+
+#include "../triple_signal/triple_signal.hpp"
+#include "triple_kernels.hpp"
+#include "triple_parallel.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Базовый класс выражения над векторами (CRTP)
+     *
+     * Выражение E обязано предоставлять:
+     * - size_t get_size() const - количество сигналов;
+     * - void load(size_t bit, uint64_t &known, uint64_t &value) const - 64 сигнала,
+     *   начиная с сигнала bit, в виде слов плоскостей known/value.
+     *   Биты за пределами get_size() не определены, потребитель обязан их маскировать.
+     *
+     * Операторы &, |, ~ и + не вычисляют результат, а строят дерево выражения,
+     * которое вычисляется за один проход при присваивании в Triple_vector.
+     * Векторы-операнды хранятся по ссылке, поэтому выражение нельзя сохранять
+     * дольше, чем живут его операнды.
+     *
+     * @tparam E Тип конкретного выражения
+     */
+    template <typename E>
+    class Triple_expr
+    {
+    public:
+        /**
+         * @brief Приведение к конкретному выражению
+         *
+         * @return const E&
+         */
+        const E &self() const
+        {
+            return static_cast<const E &>(*this);
+        }
+
+        /**
+         * @brief Количество сигналов в результате выражения
+         *
+         * @return size_t
+         */
+        size_t get_size() const
+        {
+            return self().get_size();
+        }
+
+        /**
+         * @brief 64 сигнала результата, начиная с сигнала bit
+         *
+         */
+        void load(size_t bit, uint64_t &known, uint64_t &value) const
+        {
+            self().load(bit, known, value);
+        }
+    };
+
+    /**
+     * @brief Способ хранения операнда внутри узла выражения
+     *
+     * Промежуточные узлы малы и хранятся по значению,
+     * владеющие данными листья (векторы) специализируют шаблон и хранятся по ссылке
+     *
+     * @tparam E Тип операнда
+     */
+    template <typename E>
+    struct Triple_expr_operand
+    {
+        using type = const E;
+    };
+
+    /**
+     * @brief Лист выражения из одного сигнала (правый операнд vector + signal)
+     *
+     */
+    class Triple_single : public Triple_expr<Triple_single>
+    {
+        uint64_t known_bit;
+        uint64_t value_bit;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * @param signal Сигнал
+         */
+        Triple_single(const Triple_signal &signal)
+            : known_bit(signal.get_signal() != UNKNOWN), value_bit(signal.get_signal() == ONE) {}
+
+        size_t get_size() const
+        {
+            return 1;
+        }
+
+        void load(size_t bit, uint64_t &known, uint64_t &value) const
+        {
+            known = bit == 0 ? known_bit : 0;
+            value = bit == 0 ? value_bit : 0;
+        }
+    };
+
+    /**
+     * @brief Узел поразрядного троичного И
+     *
+     * Размер результата - минимальный из размеров операндов
+     */
+    template <typename L, typename R>
+    class Triple_and : public Triple_expr<Triple_and<L, R>>
+    {
+        typename Triple_expr_operand<L>::type left_expr;
+        typename Triple_expr_operand<R>::type right_expr;
+
+    public:
+        Triple_and(const L &left, const R &right) : left_expr(left), right_expr(right) {}
+
+        const L &left() const
+        {
+            return left_expr;
+        }
+
+        const R &right() const
+        {
+            return right_expr;
+        }
+
+        size_t get_size() const
+        {
+            return std::min(left_expr.get_size(), right_expr.get_size());
+        }
+
+        void load(size_t bit, uint64_t &known, uint64_t &value) const
+        {
+            uint64_t known_1, value_1, known_2, value_2;
+            left_expr.load(bit, known_1, value_1);
+            right_expr.load(bit, known_2, value_2);
+            kernels::and_word(known_1, value_1, known_2, value_2, known, value);
+        }
+    };
+
+    /**
+     * @brief Узел поразрядного троичного ИЛИ
+     *
+     * Размер результата - минимальный из размеров операндов
+     */
+    template <typename L, typename R>
+    class Triple_or : public Triple_expr<Triple_or<L, R>>
+    {
+        typename Triple_expr_operand<L>::type left_expr;
+        typename Triple_expr_operand<R>::type right_expr;
+
+    public:
+        Triple_or(const L &left, const R &right) : left_expr(left), right_expr(right) {}
+
+        const L &left() const
+        {
+            return left_expr;
+        }
+
+        const R &right() const
+        {
+            return right_expr;
+        }
+
+        size_t get_size() const
+        {
+            return std::min(left_expr.get_size(), right_expr.get_size());
+        }
+
+        void load(size_t bit, uint64_t &known, uint64_t &value) const
+        {
+            uint64_t known_1, value_1, known_2, value_2;
+            left_expr.load(bit, known_1, value_1);
+            right_expr.load(bit, known_2, value_2);
+            kernels::or_word(known_1, value_1, known_2, value_2, known, value);
+        }
+    };
+
+    /**
+     * @brief Узел поразрядного троичного НЕ
+     *
+     */
+    template <typename E>
+    class Triple_not : public Triple_expr<Triple_not<E>>
+    {
+        typename Triple_expr_operand<E>::type operand_expr;
+
+    public:
+        explicit Triple_not(const E &operand) : operand_expr(operand) {}
+
+        const E &operand() const
+        {
+            return operand_expr;
+        }
+
+        size_t get_size() const
+        {
+            return operand_expr.get_size();
+        }
+
+        void load(size_t bit, uint64_t &known, uint64_t &value) const
+        {
+            uint64_t known_1, value_1;
+            operand_expr.load(bit, known_1, value_1);
+            kernels::not_word(known_1, value_1, known, value);
+        }
+    };
+
+    /**
+     * @brief Узел конкатенации двух выражений
+     *
+     */
+    template <typename L, typename R>
+    class Triple_concat : public Triple_expr<Triple_concat<L, R>>
+    {
+        typename Triple_expr_operand<L>::type left_expr;
+        typename Triple_expr_operand<R>::type right_expr;
+
+    public:
+        Triple_concat(const L &left, const R &right) : left_expr(left), right_expr(right) {}
+
+        const L &left() const
+        {
+            return left_expr;
+        }
+
+        const R &right() const
+        {
+            return right_expr;
+        }
+
+        size_t get_size() const
+        {
+            return left_expr.get_size() + right_expr.get_size();
+        }
+
+        void load(size_t bit, uint64_t &known, uint64_t &value) const
+        {
+            size_t left_size = left_expr.get_size();
+            if (bit >= left_size)
+            {
+                right_expr.load(bit - left_size, known, value);
+                return;
+            }
+
+            left_expr.load(bit, known, value);
+
+            size_t available = left_size - bit;
+            if (available < 64)
+            {
+                uint64_t mask = (uint64_t(1) << available) - 1;
+                uint64_t known_2, value_2;
+                right_expr.load(0, known_2, value_2);
+                known = (known & mask) | (known_2 << available);
+                value = (value & mask) | (value_2 << available);
+            }
+        }
+    };
+
+    /**
+     * @brief Может ли выражение читать память [first, last)
+     *
+     * Для листьев, о которых ничего не известно, ответ осторожный - да
+     */
+    template <typename E>
+    bool reads_memory(const Triple_expr<E> &, const uint64_t *, const uint64_t *)
+    {
+        return true;
+    }
+
+    inline bool reads_memory(const Triple_single &, const uint64_t *, const uint64_t *)
+    {
+        return false;
+    }
+
+    template <typename L, typename R>
+    bool reads_memory(const Triple_and<L, R> &expr, const uint64_t *first, const uint64_t *last)
+    {
+        return reads_memory(expr.left(), first, last) || reads_memory(expr.right(), first, last);
+    }
+
+    template <typename L, typename R>
+    bool reads_memory(const Triple_or<L, R> &expr, const uint64_t *first, const uint64_t *last)
+    {
+        return reads_memory(expr.left(), first, last) || reads_memory(expr.right(), first, last);
+    }
+
+    template <typename E>
+    bool reads_memory(const Triple_not<E> &expr, const uint64_t *first, const uint64_t *last)
+    {
+        return reads_memory(expr.operand(), first, last);
+    }
+
+    template <typename L, typename R>
+    bool reads_memory(const Triple_concat<L, R> &expr, const uint64_t *first, const uint64_t *last)
+    {
+        return reads_memory(expr.left(), first, last) || reads_memory(expr.right(), first, last);
+    }
+
+    /**
+     * @brief Может ли выражение читать память [first, last) не в той позиции, в которую пишется результат
+     *
+     * Если нет, выражение можно вычислять прямо в эту память: слово результата
+     * зависит только от слов с тем же номером, которые читаются до записи.
+     * Правый операнд конкатенации читается со сдвигом, поэтому годится, только если не читает эту память
+     */
+    template <typename E>
+    bool reads_shifted(const Triple_expr<E> &, const uint64_t *, const uint64_t *)
+    {
+        return true;
+    }
+
+    inline bool reads_shifted(const Triple_single &, const uint64_t *, const uint64_t *)
+    {
+        return false;
+    }
+
+    template <typename L, typename R>
+    bool reads_shifted(const Triple_and<L, R> &expr, const uint64_t *first, const uint64_t *last)
+    {
+        return reads_shifted(expr.left(), first, last) || reads_shifted(expr.right(), first, last);
+    }
+
+    template <typename L, typename R>
+    bool reads_shifted(const Triple_or<L, R> &expr, const uint64_t *first, const uint64_t *last)
+    {
+        return reads_shifted(expr.left(), first, last) || reads_shifted(expr.right(), first, last);
+    }
+
+    template <typename E>
+    bool reads_shifted(const Triple_not<E> &expr, const uint64_t *first, const uint64_t *last)
+    {
+        return reads_shifted(expr.operand(), first, last);
+    }
+
+    template <typename L, typename R>
+    bool reads_shifted(const Triple_concat<L, R> &expr, const uint64_t *first, const uint64_t *last)
+    {
+        return reads_shifted(expr.left(), first, last) || reads_memory(expr.right(), first, last);
+    }
+
+    /**
+     * @brief Вычисляет выражение в выровненные плоскости из words слов
+     *
+     * Универсальная версия проходит выражение по одному слову;
+     * для простых выражений над векторами есть перегрузки, вызывающие ядра triple_kernels.
+     * Широкие выражения вычисляются кусками в пуле потоков (triple_parallel)
+     */
+    template <typename E>
+    void evaluate_planes(const E &expr, uint64_t *known, uint64_t *value, size_t words)
+    {
+        parallel::for_chunks(words, [&](size_t first, size_t last)
+                             {
+            for (size_t i = first; i < last; i++)
+            {
+                expr.load(i * 64, known[i], value[i]);
+            } });
+    }
+
+    /**
+     * @brief Оператор поразрядного логического И
+     *
+     * @return Triple_and Ленивое выражение
+     */
+    template <typename L, typename R>
+    Triple_and<L, R> operator&(const Triple_expr<L> &left, const Triple_expr<R> &right)
+    {
+        return Triple_and<L, R>(left.self(), right.self());
+    }
+
+    /**
+     * @brief Оператор поразрядного логического ИЛИ
+     *
+     * @return Triple_or Ленивое выражение
+     */
+    template <typename L, typename R>
+    Triple_or<L, R> operator|(const Triple_expr<L> &left, const Triple_expr<R> &right)
+    {
+        return Triple_or<L, R>(left.self(), right.self());
+    }
+
+    /**
+     * @brief Оператор поразрядного логического НЕ
+     *
+     * @return Triple_not Ленивое выражение
+     */
+    template <typename E>
+    Triple_not<E> operator~(const Triple_expr<E> &operand)
+    {
+        return Triple_not<E>(operand.self());
+    }
+
+    /**
+     * @brief Сложение (конкатенация) выражений
+     *
+     * @return Triple_concat Ленивое выражение
+     */
+    template <typename L, typename R>
+    Triple_concat<L, R> operator+(const Triple_expr<L> &left, const Triple_expr<R> &right)
+    {
+        return Triple_concat<L, R>(left.self(), right.self());
+    }
+
+    /**
+     * @brief Сложение выражения с сигналом
+     *
+     * @return Triple_concat Ленивое выражение
+     */
+    template <typename L>
+    Triple_concat<L, Triple_single> operator+(const Triple_expr<L> &left, const Triple_signal &signal)
+    {
+        return Triple_concat<L, Triple_single>(left.self(), Triple_single(signal));
+    }
+
+    /**
+     * @brief Сравнение результатов двух выражений без их материализации
+     *
+     * @return true Размеры и все сигналы совпадают
+     * @return false Иначе
+     */
+    template <typename L, typename R>
+    bool operator==(const Triple_expr<L> &left, const Triple_expr<R> &right)
+    {
+        size_t size = left.get_size();
+        if (size != right.get_size())
+            return false;
+
+        std::atomic<bool> equal{true};
+        parallel::for_chunks((size + 63) / 64, [&](size_t first, size_t last)
+                             {
+            for (size_t bit = first * 64; bit < last * 64 && bit < size; bit += 64)
+            {
+                uint64_t known_1, value_1, known_2, value_2;
+                left.load(bit, known_1, value_1);
+                right.load(bit, known_2, value_2);
+
+                uint64_t mask = size - bit >= 64 ? ~uint64_t(0) : (uint64_t(1) << (size - bit)) - 1;
+                if (((known_1 ^ known_2) | (value_1 ^ value_2)) & mask)
+                {
+                    equal.store(false, std::memory_order_relaxed);
+                    return;
+                }
+                // Другой кусок уже нашел различие
+                if (bit % 4096 == 0 && !equal.load(std::memory_order_relaxed))
+                    return;
+            } });
+        return equal;
+    }
+
+    /**
+     * @brief Сравнение результатов двух выражений на неравенство
+     *
+     */
+    template <typename L, typename R>
+    bool operator!=(const Triple_expr<L> &left, const Triple_expr<R> &right)
+    {
+        return !(left == right);
+    }
+}
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file triple_format.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий вывод векторов троичных сигналов без выделения памяти
+ * @version 0.1
+ * @date 2025-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_FORMAT_H
+#define TRIPLE_FORMAT_H
+
+#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#include "triple_expr.hpp"
+#include "triple_kernels.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Размер блока символов на стеке при выводе в поток и std::format
+     *
+     */
+    constexpr size_t format_block = 4096;
+
+    /**
+     * @brief Запись count сигналов выражения, начиная с сигнала first, символами 0/1/X
+     *
+     * @param expr Выражение или вектор
+     * @param first Номер первого сигнала
+     * @param count Количество сигналов
+     * @param out Буфер не меньше count символов
+     */
+    template <typename E>
+    void format_range(const Triple_expr<E> &expr, size_t first, size_t count, char *out)
+    {
+        for (size_t bit = 0; bit < count; bit += 64)
+        {
+            uint64_t known, value;
+            expr.load(first + bit, known, value);
+            kernels::format_signals(&known, &value, std::min<size_t>(count - bit, 64), out + bit);
+        }
+    }
+
+    /**
+     * @brief Запись сигналов выражения символами 0/1/X без выделения памяти
+     *
+     * @param first Начало буфера
+     * @param last Конец буфера
+     * @param expr Выражение или вектор
+     * @return std::to_chars_result ptr - за последним записанным символом;
+     * ec == std::errc::value_too_large (буфер не изменен), если сигналы не помещаются
+     */
+    template <typename E>
+    std::to_chars_result to_chars(char *first, char *last, const Triple_expr<E> &expr)
+    {
+        size_t size = expr.get_size();
+        if (static_cast<size_t>(last - first) < size)
+            return {last, std::errc::value_too_large};
+
+        format_range(expr, 0, size, first);
+        return {first + size, std::errc()};
+    }
+
+    /**
+     * @brief Вывод сигналов выражения в поток без промежуточной строки
+     *
+     * Символы пишутся прямо в буфер потока блоками по format_block,
+     * ширина и заполнитель потока (std::setw, std::left) учитываются как для строки
+     *
+     * @param out Поток вывода
+     * @param expr Выражение или вектор
+     * @return std::ostream& Ссылка на выходной поток
+     */
+    template <typename E>
+    std::ostream &write_signals(std::ostream &out, const Triple_expr<E> &expr)
+    {
+        std::ostream::sentry sentry(out);
+        if (!sentry)
+            return out;
+
+        std::streambuf *buffer = out.rdbuf();
+        size_t size = expr.get_size();
+        size_t width = out.width() > 0 ? static_cast<size_t>(out.width()) : 0;
+        size_t padding = width > size ? width - size : 0;
+        bool left = (out.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+
+        auto pad = [&]()
+        {
+            for (size_t i = 0; i < padding; i++)
+            {
+                if (std::char_traits<char>::eq_int_type(buffer->sputc(out.fill()), std::char_traits<char>::eof()))
+                    return false;
+            }
+            return true;
+        };
+
+        bool written = left || pad();
+        char block[format_block];
+        for (size_t first = 0; written && first < size; first += format_block)
+        {
+            size_t count = std::min(format_block, size - first);
+            format_range(expr, first, count, block);
+            written = buffer->sputn(block, count) == static_cast<std::streamsize>(count);
+        }
+        if (written && left)
+            written = pad();
+
+        out.width(0);
+        if (!written)
+            out.setstate(std::ios_base::badbit);
+        return out;
+    }
+}
+
+#ifdef __cpp_lib_format
+/**
+ * @brief Форматирование векторов, представлений и выражений через std::format
+ *
+ * Выводится 0/1/X блоками по format_block символов без промежуточной строки.
+ * Спецификаторы формата не поддерживаются: только "{}"
+ */
+template <typename E>
+    requires std::derived_from<E, Triple_signal::Triple_expr<E>>
+struct std::formatter<E, char>
+{
+    constexpr auto parse(std::format_parse_context &context)
+    {
+        auto position = context.begin();
+        if (position != context.end() && *position != '}')
+            throw std::format_error("format specifiers are not supported for signal vectors");
+        return position;
+    }
+
+    template <typename Context>
+    auto format(const E &expr, Context &context) const
+    {
+        auto out = context.out();
+        char block[Triple_signal::format_block];
+        size_t size = expr.get_size();
+        for (size_t first = 0; first < size; first += Triple_signal::format_block)
+        {
+            size_t count = std::min(Triple_signal::format_block, size - first);
+            Triple_signal::format_range(expr, first, count, block);
+            out = std::copy_n(block, count, out);
+        }
+        return out;
+    }
+};
+#endif
+
+#endif
@@ -0,0 +1,35 @@
+#include "triple_intern.hpp"
+
+namespace Triple_signal
+{
+    Triple_vector Triple_intern_table::intern(const Triple_vector &vector)
+    {
+        return *table.insert(vector).first;
+    }
+
+    size_t Triple_intern_table::collect()
+    {
+        size_t removed = 0;
+        for (auto it = table.begin(); it != table.end();)
+        {
+            if (it->get_use_count() == 1)
+            {
+                it = table.erase(it);
+                removed++;
+            }
+            else
+                ++it;
+        }
+        return removed;
+    }
+
+    size_t Triple_intern_table::get_size() const
+    {
+        return table.size();
+    }
+
+    void Triple_intern_table::clear()
+    {
+        table.clear();
+    }
+}
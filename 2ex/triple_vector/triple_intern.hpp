@@ -0,0 +1,69 @@
+/**
+ * @file triple_intern.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий таблицу интернирования векторов троичных сигналов
+ * @version 0.1
+ * @date 2025-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_INTERN_H
+#define TRIPLE_INTERN_H
+
+#include <cstddef>
+#include <unordered_set>
+
+#include "triple_vector.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Таблица интернирования (hash-consing) векторов
+     *
+     * Для равных по содержимому векторов intern возвращает копии одного и того же
+     * разделяемого буфера, поэтому повторяющиеся значения большого состояния симуляции
+     * хранятся в памяти один раз, а их сравнение сводится к сравнению указателей.
+     * Таблица не потокобезопасна.
+     */
+    class Triple_intern_table
+    {
+        std::unordered_set<Triple_vector> table;
+
+    public:
+        /**
+         * @brief Возвращает канонический экземпляр вектора
+         *
+         * Если равный вектор уже есть в таблице, возвращается его копия (общий буфер),
+         * иначе вектор добавляется в таблицу
+         *
+         * @param vector Вектор
+         * @return Triple_vector Копия канонического экземпляра
+         */
+        Triple_vector intern(const Triple_vector &vector);
+
+        /**
+         * @brief Удаляет векторы, на которые не ссылается никто, кроме таблицы
+         *
+         * Короткие векторы во встроенном буфере не разделяются и удаляются всегда
+         *
+         * @return size_t Количество удаленных векторов
+         */
+        size_t collect();
+
+        /**
+         * @brief Количество различных векторов в таблице
+         *
+         * @return size_t
+         */
+        size_t get_size() const;
+
+        /**
+         * @brief Очищает таблицу
+         *
+         */
+        void clear();
+    };
+}
+
+#endif
@@ -0,0 +1,535 @@
+#include <array>
+#include <bit>
+#include <cstring>
+#include <initializer_list>
+
+#include "triple_kernels.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRIPLE_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace Triple_signal
+{
+    namespace kernels
+    {
+        namespace
+        {
+            using Binary_kernel = void (*)(const uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *,
+                                           uint64_t *, uint64_t *, size_t);
+            using Unary_kernel = void (*)(const uint64_t *, const uint64_t *, uint64_t *, uint64_t *, size_t);
+            using Reduce_kernel = bool (*)(const uint64_t *, size_t);
+            using Parse_kernel = size_t (*)(const char *, size_t, uint64_t *, uint64_t *);
+
+            struct Kernel_table
+            {
+                Isa isa;
+                Binary_kernel and_planes;
+                Binary_kernel or_planes;
+                Unary_kernel not_planes;
+                Reduce_kernel all_ones;
+                Parse_kernel parse_signals;
+            };
+
+            // Код символа: бит 0 - value, бит 1 - known, бит 2 - недопустимый символ
+            constexpr uint8_t CODE_ZERO = 0b010;
+            constexpr uint8_t CODE_ONE = 0b011;
+            constexpr uint8_t CODE_UNKNOWN = 0b000;
+            constexpr uint8_t CODE_INVALID = 0b100;
+
+            constexpr std::array<uint8_t, 256> make_char_codes()
+            {
+                std::array<uint8_t, 256> codes{};
+                for (auto &code : codes)
+                    code = CODE_INVALID;
+                codes['0'] = CODE_ZERO;
+                codes['1'] = CODE_ONE;
+                codes['x'] = CODE_UNKNOWN;
+                codes['X'] = CODE_UNKNOWN;
+                return codes;
+            }
+
+            constexpr std::array<uint8_t, 256> char_codes = make_char_codes();
+
+            // Байт из 8 бит -> 8 байт со значениями 0/1 (бит i -> байт i)
+            constexpr std::array<uint64_t, 256> make_spread_bits()
+            {
+                std::array<uint64_t, 256> spread{};
+                for (size_t byte = 0; byte < 256; byte++)
+                {
+                    for (size_t bit = 0; bit < 8; bit++)
+                    {
+                        if (byte & (size_t(1) << bit))
+                            spread[byte] |= uint64_t(1) << (8 * bit);
+                    }
+                }
+                return spread;
+            }
+
+            constexpr std::array<uint64_t, 256> spread_bits = make_spread_bits();
+
+            // Разбирает до 64 символов в одно слово, возвращает false при недопустимом символе
+            bool parse_word_scalar(const char *text, size_t count, uint64_t &known, uint64_t &value)
+            {
+                uint8_t invalid = 0;
+                known = value = 0;
+                for (size_t j = 0; j < count; j++)
+                {
+                    uint8_t code = char_codes[static_cast<uint8_t>(text[j])];
+                    invalid |= code;
+                    known |= uint64_t((code >> 1) & 1) << j;
+                    value |= uint64_t(code & 1) << j;
+                }
+                return !(invalid & CODE_INVALID);
+            }
+
+            size_t first_invalid(const char *text, size_t length)
+            {
+                for (size_t i = 0; i < length; i++)
+                {
+                    if (char_codes[static_cast<uint8_t>(text[i])] == CODE_INVALID)
+                        return i;
+                }
+                return length;
+            }
+
+            size_t parse_scalar(const char *text, size_t length, uint64_t *known, uint64_t *value)
+            {
+                for (size_t word = 0; word * 64 < length; word++)
+                {
+                    size_t count = length - word * 64 < 64 ? length - word * 64 : 64;
+                    if (!parse_word_scalar(text + word * 64, count, known[word], value[word]))
+                        return word * 64 + first_invalid(text + word * 64, count);
+                }
+                return length;
+            }
+
+            void and_scalar(const uint64_t *known_1, const uint64_t *value_1,
+                            const uint64_t *known_2, const uint64_t *value_2,
+                            uint64_t *known, uint64_t *value, size_t words)
+            {
+                for (size_t i = 0; i < words; i++)
+                {
+                    and_word(known_1[i], value_1[i], known_2[i], value_2[i], known[i], value[i]);
+                }
+            }
+
+            void or_scalar(const uint64_t *known_1, const uint64_t *value_1,
+                           const uint64_t *known_2, const uint64_t *value_2,
+                           uint64_t *known, uint64_t *value, size_t words)
+            {
+                for (size_t i = 0; i < words; i++)
+                {
+                    or_word(known_1[i], value_1[i], known_2[i], value_2[i], known[i], value[i]);
+                }
+            }
+
+            void not_scalar(const uint64_t *known_1, const uint64_t *value_1,
+                            uint64_t *known, uint64_t *value, size_t words)
+            {
+                for (size_t i = 0; i < words; i++)
+                {
+                    not_word(known_1[i], value_1[i], known[i], value[i]);
+                }
+            }
+
+            bool all_ones_scalar(const uint64_t *plane, size_t words)
+            {
+                uint64_t acc = ~uint64_t(0);
+                for (size_t i = 0; i < words; i++)
+                {
+                    acc &= plane[i];
+                }
+                return acc == ~uint64_t(0);
+            }
+
+#ifdef TRIPLE_KERNELS_X86
+            // SSE2: 2 слова (128 сигналов) за итерацию
+
+            __attribute__((target("sse2"))) void and_sse2(const uint64_t *known_1, const uint64_t *value_1,
+                                                          const uint64_t *known_2, const uint64_t *value_2,
+                                                          uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 2 <= words; i += 2)
+                {
+                    __m128i k_1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(known_1 + i));
+                    __m128i v_1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value_1 + i));
+                    __m128i k_2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(known_2 + i));
+                    __m128i v_2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value_2 + i));
+
+                    __m128i k = _mm_or_si128(_mm_and_si128(k_1, k_2),
+                                             _mm_or_si128(_mm_andnot_si128(v_1, k_1), _mm_andnot_si128(v_2, k_2)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(known + i), k);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(value + i), _mm_and_si128(v_1, v_2));
+                }
+                and_scalar(known_1 + i, value_1 + i, known_2 + i, value_2 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("sse2"))) void or_sse2(const uint64_t *known_1, const uint64_t *value_1,
+                                                         const uint64_t *known_2, const uint64_t *value_2,
+                                                         uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 2 <= words; i += 2)
+                {
+                    __m128i k_1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(known_1 + i));
+                    __m128i v_1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value_1 + i));
+                    __m128i k_2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(known_2 + i));
+                    __m128i v_2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value_2 + i));
+
+                    __m128i v = _mm_or_si128(v_1, v_2);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(known + i), _mm_or_si128(_mm_and_si128(k_1, k_2), v));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(value + i), v);
+                }
+                or_scalar(known_1 + i, value_1 + i, known_2 + i, value_2 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("sse2"))) void not_sse2(const uint64_t *known_1, const uint64_t *value_1,
+                                                          uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 2 <= words; i += 2)
+                {
+                    __m128i k_1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(known_1 + i));
+                    __m128i v_1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(value_1 + i));
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(known + i), k_1);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(value + i), _mm_andnot_si128(v_1, k_1));
+                }
+                not_scalar(known_1 + i, value_1 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("sse2"))) bool all_ones_sse2(const uint64_t *plane, size_t words)
+            {
+                __m128i acc = _mm_set1_epi32(-1);
+                size_t i = 0;
+                for (; i + 2 <= words; i += 2)
+                {
+                    acc = _mm_and_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i *>(plane + i)));
+                }
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_set1_epi32(-1))) == 0xFFFF &&
+                       all_ones_scalar(plane + i, words - i);
+            }
+
+            __attribute__((target("sse2"))) size_t parse_sse2(const char *text, size_t length, uint64_t *known, uint64_t *value)
+            {
+                const __m128i zero = _mm_set1_epi8('0');
+                const __m128i one = _mm_set1_epi8('1');
+                const __m128i unknown = _mm_set1_epi8('x');
+                const __m128i lower = _mm_set1_epi8(0x20);
+
+                size_t word = 0;
+                for (; (word + 1) * 64 <= length; word++)
+                {
+                    uint64_t is_zero = 0, is_one = 0, is_unknown = 0;
+                    for (size_t chunk = 0; chunk < 4; chunk++)
+                    {
+                        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + word * 64 + chunk * 16));
+                        size_t shift = chunk * 16;
+                        is_zero |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(c, zero)))) << shift;
+                        is_one |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(c, one)))) << shift;
+                        is_unknown |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(c, lower), unknown)))) << shift;
+                    }
+                    if ((is_zero | is_one | is_unknown) != ~uint64_t(0))
+                        return word * 64 + first_invalid(text + word * 64, 64);
+
+                    known[word] = is_zero | is_one;
+                    value[word] = is_one;
+                }
+
+                size_t rest = parse_scalar(text + word * 64, length - word * 64, known + word, value + word);
+                return word * 64 + rest;
+            }
+
+            // AVX2: 4 слова (256 сигналов) за итерацию
+
+            __attribute__((target("avx2"))) void and_avx2(const uint64_t *known_1, const uint64_t *value_1,
+                                                          const uint64_t *known_2, const uint64_t *value_2,
+                                                          uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 4 <= words; i += 4)
+                {
+                    __m256i k_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(known_1 + i));
+                    __m256i v_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(value_1 + i));
+                    __m256i k_2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(known_2 + i));
+                    __m256i v_2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(value_2 + i));
+
+                    __m256i k = _mm256_or_si256(_mm256_and_si256(k_1, k_2),
+                                                _mm256_or_si256(_mm256_andnot_si256(v_1, k_1), _mm256_andnot_si256(v_2, k_2)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(known + i), k);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(value + i), _mm256_and_si256(v_1, v_2));
+                }
+                and_scalar(known_1 + i, value_1 + i, known_2 + i, value_2 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("avx2"))) void or_avx2(const uint64_t *known_1, const uint64_t *value_1,
+                                                         const uint64_t *known_2, const uint64_t *value_2,
+                                                         uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 4 <= words; i += 4)
+                {
+                    __m256i k_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(known_1 + i));
+                    __m256i v_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(value_1 + i));
+                    __m256i k_2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(known_2 + i));
+                    __m256i v_2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(value_2 + i));
+
+                    __m256i v = _mm256_or_si256(v_1, v_2);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(known + i), _mm256_or_si256(_mm256_and_si256(k_1, k_2), v));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(value + i), v);
+                }
+                or_scalar(known_1 + i, value_1 + i, known_2 + i, value_2 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("avx2"))) void not_avx2(const uint64_t *known_1, const uint64_t *value_1,
+                                                          uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 4 <= words; i += 4)
+                {
+                    __m256i k_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(known_1 + i));
+                    __m256i v_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(value_1 + i));
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(known + i), k_1);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(value + i), _mm256_andnot_si256(v_1, k_1));
+                }
+                not_scalar(known_1 + i, value_1 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("avx2"))) bool all_ones_avx2(const uint64_t *plane, size_t words)
+            {
+                __m256i ones = _mm256_set1_epi64x(-1);
+                __m256i acc = ones;
+                size_t i = 0;
+                for (; i + 4 <= words; i += 4)
+                {
+                    acc = _mm256_and_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(plane + i)));
+                }
+                return _mm256_testc_si256(acc, ones) && all_ones_scalar(plane + i, words - i);
+            }
+
+            __attribute__((target("avx2"))) size_t parse_avx2(const char *text, size_t length, uint64_t *known, uint64_t *value)
+            {
+                const __m256i zero = _mm256_set1_epi8('0');
+                const __m256i one = _mm256_set1_epi8('1');
+                const __m256i unknown = _mm256_set1_epi8('x');
+                const __m256i lower = _mm256_set1_epi8(0x20);
+
+                size_t word = 0;
+                for (; (word + 1) * 64 <= length; word++)
+                {
+                    uint64_t is_zero = 0, is_one = 0, is_unknown = 0;
+                    for (size_t chunk = 0; chunk < 2; chunk++)
+                    {
+                        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + word * 64 + chunk * 32));
+                        size_t shift = chunk * 32;
+                        is_zero |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, zero)))) << shift;
+                        is_one |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, one)))) << shift;
+                        is_unknown |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_or_si256(c, lower), unknown)))) << shift;
+                    }
+                    if ((is_zero | is_one | is_unknown) != ~uint64_t(0))
+                        return word * 64 + first_invalid(text + word * 64, 64);
+
+                    known[word] = is_zero | is_one;
+                    value[word] = is_one;
+                }
+
+                size_t rest = parse_scalar(text + word * 64, length - word * 64, known + word, value + word);
+                return word * 64 + rest;
+            }
+
+            // AVX-512: 8 слов (512 сигналов) за итерацию, составные выражения через vpternlogq
+
+            __attribute__((target("avx512f"))) void and_avx512(const uint64_t *known_1, const uint64_t *value_1,
+                                                               const uint64_t *known_2, const uint64_t *value_2,
+                                                               uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 8 <= words; i += 8)
+                {
+                    __m512i k_1 = _mm512_loadu_si512(known_1 + i);
+                    __m512i v_1 = _mm512_loadu_si512(value_1 + i);
+                    __m512i k_2 = _mm512_loadu_si512(known_2 + i);
+                    __m512i v_2 = _mm512_loadu_si512(value_2 + i);
+
+                    // known = k_1 & (k_2 | ~v_1) | k_2 & ~v_2
+                    __m512i k = _mm512_ternarylogic_epi64(k_1, k_2, v_1, 0xD0);
+                    k = _mm512_ternarylogic_epi64(k, k_2, v_2, 0xF4);
+                    _mm512_storeu_si512(known + i, k);
+                    _mm512_storeu_si512(value + i, _mm512_and_si512(v_1, v_2));
+                }
+                and_scalar(known_1 + i, value_1 + i, known_2 + i, value_2 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("avx512f"))) void or_avx512(const uint64_t *known_1, const uint64_t *value_1,
+                                                              const uint64_t *known_2, const uint64_t *value_2,
+                                                              uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 8 <= words; i += 8)
+                {
+                    __m512i k_1 = _mm512_loadu_si512(known_1 + i);
+                    __m512i v_1 = _mm512_loadu_si512(value_1 + i);
+                    __m512i k_2 = _mm512_loadu_si512(known_2 + i);
+                    __m512i v_2 = _mm512_loadu_si512(value_2 + i);
+
+                    __m512i v = _mm512_or_si512(v_1, v_2);
+                    _mm512_storeu_si512(known + i, _mm512_ternarylogic_epi64(v, k_1, k_2, 0xF8));
+                    _mm512_storeu_si512(value + i, v);
+                }
+                or_scalar(known_1 + i, value_1 + i, known_2 + i, value_2 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("avx512f"))) void not_avx512(const uint64_t *known_1, const uint64_t *value_1,
+                                                               uint64_t *known, uint64_t *value, size_t words)
+            {
+                size_t i = 0;
+                for (; i + 8 <= words; i += 8)
+                {
+                    __m512i k_1 = _mm512_loadu_si512(known_1 + i);
+                    __m512i v_1 = _mm512_loadu_si512(value_1 + i);
+
+                    _mm512_storeu_si512(known + i, k_1);
+                    _mm512_storeu_si512(value + i, _mm512_ternarylogic_epi64(k_1, v_1, v_1, 0x30));
+                }
+                not_scalar(known_1 + i, value_1 + i, known + i, value + i, words - i);
+            }
+
+            __attribute__((target("avx512f"))) bool all_ones_avx512(const uint64_t *plane, size_t words)
+            {
+                __m512i ones = _mm512_set1_epi64(-1);
+                __m512i acc = ones;
+                size_t i = 0;
+                for (; i + 8 <= words; i += 8)
+                {
+                    acc = _mm512_and_si512(acc, _mm512_loadu_si512(plane + i));
+                }
+                return _mm512_cmpneq_epi64_mask(acc, ones) == 0 && all_ones_scalar(plane + i, words - i);
+            }
+#endif
+
+            Kernel_table table_for(Isa isa)
+            {
+                switch (isa)
+                {
+#ifdef TRIPLE_KERNELS_X86
+                case Isa::AVX512:
+                    return {Isa::AVX512, and_avx512, or_avx512, not_avx512, all_ones_avx512, parse_avx2};
+                case Isa::AVX2:
+                    return {Isa::AVX2, and_avx2, or_avx2, not_avx2, all_ones_avx2, parse_avx2};
+                case Isa::SSE2:
+                    return {Isa::SSE2, and_sse2, or_sse2, not_sse2, all_ones_sse2, parse_sse2};
+#endif
+                default:
+                    return {Isa::SCALAR, and_scalar, or_scalar, not_scalar, all_ones_scalar, parse_scalar};
+                }
+            }
+
+            bool supported(Isa isa)
+            {
+                switch (isa)
+                {
+                case Isa::SCALAR:
+                    return true;
+#ifdef TRIPLE_KERNELS_X86
+                case Isa::SSE2:
+                    return __builtin_cpu_supports("sse2");
+                case Isa::AVX2:
+                    return __builtin_cpu_supports("avx2");
+                case Isa::AVX512:
+                    return __builtin_cpu_supports("avx512f");
+#endif
+                default:
+                    return false;
+                }
+            }
+
+            Kernel_table &active()
+            {
+                static Kernel_table table = table_for(detect_isa());
+                return table;
+            }
+        }
+
+        Isa detect_isa()
+        {
+            for (Isa isa : {Isa::AVX512, Isa::AVX2, Isa::SSE2})
+            {
+                if (supported(isa))
+                    return isa;
+            }
+            return Isa::SCALAR;
+        }
+
+        Isa get_isa()
+        {
+            return active().isa;
+        }
+
+        bool set_isa(Isa isa)
+        {
+            if (!supported(isa))
+                return false;
+
+            active() = table_for(isa);
+            return true;
+        }
+
+        void and_planes(const uint64_t *known_1, const uint64_t *value_1,
+                        const uint64_t *known_2, const uint64_t *value_2,
+                        uint64_t *known, uint64_t *value, size_t words)
+        {
+            active().and_planes(known_1, value_1, known_2, value_2, known, value, words);
+        }
+
+        void or_planes(const uint64_t *known_1, const uint64_t *value_1,
+                       const uint64_t *known_2, const uint64_t *value_2,
+                       uint64_t *known, uint64_t *value, size_t words)
+        {
+            active().or_planes(known_1, value_1, known_2, value_2, known, value, words);
+        }
+
+        void not_planes(const uint64_t *known_1, const uint64_t *value_1,
+                        uint64_t *known, uint64_t *value, size_t words)
+        {
+            active().not_planes(known_1, value_1, known, value, words);
+        }
+
+        bool all_ones(const uint64_t *plane, size_t words)
+        {
+            return active().all_ones(plane, words);
+        }
+
+        size_t parse_signals(const char *text, size_t length, uint64_t *known, uint64_t *value)
+        {
+            return active().parse_signals(text, length, known, value);
+        }
+
+        void format_signals(const uint64_t *known, const uint64_t *value, size_t size, char *out)
+        {
+            // 'X' - 0x28 * known + value дает '0', '1' или 'X' в каждом байте без переносов
+            constexpr uint64_t all_x = 0x5858585858585858;
+            constexpr uint64_t x_to_zero = 0x28;
+
+            size_t i = 0;
+            for (; std::endian::native == std::endian::little && i + 8 <= size; i += 8)
+            {
+                uint8_t known_byte = static_cast<uint8_t>(known[i / 64] >> (i % 64));
+                uint8_t value_byte = static_cast<uint8_t>(value[i / 64] >> (i % 64));
+                uint64_t chars = all_x - x_to_zero * spread_bits[known_byte] + spread_bits[value_byte];
+                std::memcpy(out + i, &chars, 8);
+            }
+            for (; i < size; i++)
+            {
+                uint64_t bit = uint64_t(1) << (i % 64);
+                if (!(known[i / 64] & bit))
+                    out[i] = 'X';
+                else
+                    out[i] = (value[i / 64] & bit) ? '1' : '0';
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file triple_kernels.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий ядра троичной логики над битовыми плоскостями
+ * @version 0.1
+ * @date 2025-10-06
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_KERNELS_H
+#define TRIPLE_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Triple_signal
+{
+    namespace kernels
+    {
+        /**
+         * @brief Набор инструкций, которым выполняются ядра
+         *
+         */
+        enum class Isa
+        {
+            SCALAR, ///< Переносимая реализация по 64 сигнала
+            SSE2,   ///< 128 сигналов за инструкцию
+            AVX2,   ///< 256 сигналов за инструкцию
+            AVX512  ///< 512 сигналов за инструкцию
+        };
+
+        /**
+         * @brief Троичное И для одного слова плоскостей
+         *
+         * Результат определен, если оба сигнала определены или хотя бы один из них равен ZERO
+         */
+        constexpr void and_word(uint64_t known_1, uint64_t value_1, uint64_t known_2, uint64_t value_2,
+                             uint64_t &known, uint64_t &value)
+        {
+            known = (known_1 & known_2) | (known_1 & ~value_1) | (known_2 & ~value_2);
+            value = value_1 & value_2;
+        }
+
+        /**
+         * @brief Троичное ИЛИ для одного слова плоскостей
+         *
+         * Результат определен, если оба сигнала определены или хотя бы один из них равен ONE
+         */
+        constexpr void or_word(uint64_t known_1, uint64_t value_1, uint64_t known_2, uint64_t value_2,
+                            uint64_t &known, uint64_t &value)
+        {
+            value = value_1 | value_2;
+            known = (known_1 & known_2) | value;
+        }
+
+        /**
+         * @brief Троичное НЕ для одного слова плоскостей
+         *
+         */
+        constexpr void not_word(uint64_t known_1, uint64_t value_1, uint64_t &known, uint64_t &value)
+        {
+            known = known_1;
+            value = known_1 & ~value_1;
+        }
+
+        /**
+         * @brief Самый широкий набор инструкций, поддерживаемый процессором
+         *
+         * @return Isa
+         */
+        Isa detect_isa();
+
+        /**
+         * @brief Набор инструкций, выбранный для ядер
+         *
+         * По умолчанию - результат detect_isa()
+         *
+         * @return Isa
+         */
+        Isa get_isa();
+
+        /**
+         * @brief Принудительно выбирает набор инструкций (например, для тестов)
+         *
+         * @param isa
+         * @return true Набор поддерживается и выбран
+         * @return false Процессор не поддерживает набор, выбор не изменен
+         */
+        bool set_isa(Isa isa);
+
+        /**
+         * @brief Поразрядное троичное И над words словами плоскостей
+         *
+         * Выходные плоскости могут совпадать с входными
+         */
+        void and_planes(const uint64_t *known_1, const uint64_t *value_1,
+                        const uint64_t *known_2, const uint64_t *value_2,
+                        uint64_t *known, uint64_t *value, size_t words);
+
+        /**
+         * @brief Поразрядное троичное ИЛИ над words словами плоскостей
+         *
+         * Выходные плоскости могут совпадать с входными
+         */
+        void or_planes(const uint64_t *known_1, const uint64_t *value_1,
+                       const uint64_t *known_2, const uint64_t *value_2,
+                       uint64_t *known, uint64_t *value, size_t words);
+
+        /**
+         * @brief Поразрядное троичное НЕ над words словами плоскостей
+         *
+         * Выходные плоскости могут совпадать с входными
+         */
+        void not_planes(const uint64_t *known_1, const uint64_t *value_1,
+                        uint64_t *known, uint64_t *value, size_t words);
+
+        /**
+         * @brief Проверка, что все words слов плоскости состоят из единиц
+         *
+         * @return true Все биты установлены
+         * @return false Есть хотя бы один нулевой бит
+         */
+        bool all_ones(const uint64_t *plane, size_t words);
+
+        /**
+         * @brief Разбор строки сигналов 0/1/x/X в обнуленные плоскости
+         *
+         * Символы классифицируются блоками по 16 (SSE2) или 32 (AVX2) байта
+         *
+         * @param text Строка сигналов
+         * @param length Длина строки
+         * @param known Плоскость known, не меньше (length + 63) / 64 слов
+         * @param value Плоскость value, не меньше (length + 63) / 64 слов
+         * @return size_t length, если строка корректна, иначе индекс первого недопустимого символа
+         */
+        size_t parse_signals(const char *text, size_t length, uint64_t *known, uint64_t *value);
+
+        /**
+         * @brief Запись size сигналов из плоскостей в виде символов 0/1/X
+         *
+         * Обрабатывает по 8 сигналов за шаг через таблицу без ветвлений
+         *
+         * @param known Плоскость known
+         * @param value Плоскость value
+         * @param size Количество сигналов
+         * @param out Буфер не меньше size символов
+         */
+        void format_signals(const uint64_t *known, const uint64_t *value, size_t size, char *out);
+    }
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "triple_parallel.hpp"
+
+namespace Triple_signal
+{
+    namespace parallel
+    {
+        namespace
+        {
+            /**
+             * @brief Пул потоков, разбирающих куски одной задачи
+             *
+             * Вызывающий поток тоже обрабатывает куски, поэтому рабочих на один меньше
+             */
+            class Thread_pool
+            {
+                std::vector<std::thread> workers;
+                std::mutex mutex;
+                std::condition_variable wake;
+                std::condition_variable done;
+
+                void (*task)(const void *, size_t, size_t) = nullptr;
+                const void *context = nullptr;
+                size_t words = 0;
+                size_t chunk = 0;
+                std::atomic<size_t> next_chunk{0};
+                size_t active = 0;
+                size_t generation = 0;
+                bool stopping = false;
+
+                void work()
+                {
+                    size_t chunks = (words + chunk - 1) / chunk;
+                    for (size_t index = next_chunk++; index < chunks; index = next_chunk++)
+                    {
+                        size_t first = index * chunk;
+                        task(context, first, std::min(words, first + chunk));
+                    }
+                }
+
+                void worker_loop()
+                {
+                    size_t seen = 0;
+                    while (true)
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            wake.wait(lock, [&]
+                                      { return stopping || generation != seen; });
+                            if (stopping)
+                                return;
+                            seen = generation;
+                        }
+
+                        work();
+
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (--active == 0)
+                            done.notify_one();
+                    }
+                }
+
+            public:
+                explicit Thread_pool(size_t threads)
+                {
+                    for (size_t i = 1; i < threads; i++)
+                        workers.emplace_back(&Thread_pool::worker_loop, this);
+                }
+
+                ~Thread_pool()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        stopping = true;
+                    }
+                    wake.notify_all();
+                    for (std::thread &worker : workers)
+                        worker.join();
+                }
+
+                size_t get_threads() const
+                {
+                    return workers.size() + 1;
+                }
+
+                void run(size_t total, void (*function)(const void *, size_t, size_t), const void *argument)
+                {
+                    // Примерно 4 куска на поток сглаживают неравномерную загрузку ядер
+                    size_t target = (total + 4 * get_threads() - 1) / (4 * get_threads());
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        task = function;
+                        context = argument;
+                        words = total;
+                        chunk = std::max(chunk_words, (target + chunk_words - 1) / chunk_words * chunk_words);
+                        next_chunk = 0;
+                        active = workers.size();
+                        generation++;
+                    }
+                    wake.notify_all();
+
+                    work();
+
+                    std::unique_lock<std::mutex> lock(mutex);
+                    done.wait(lock, [&]
+                              { return active == 0; });
+                }
+            };
+
+            std::atomic<size_t> threshold{16384};
+            std::atomic<size_t> thread_count{0};
+
+            std::mutex pool_mutex;
+            std::unique_ptr<Thread_pool> pool;
+
+            size_t hardware_threads()
+            {
+                return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            }
+        }
+
+        void set_threads(size_t threads)
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            pool.reset();
+            thread_count = threads == 0 ? hardware_threads() : threads;
+        }
+
+        size_t get_threads()
+        {
+            size_t threads = thread_count;
+            return threads == 0 ? hardware_threads() : threads;
+        }
+
+        void set_threshold(size_t words)
+        {
+            threshold = words;
+        }
+
+        size_t get_threshold()
+        {
+            return threshold;
+        }
+
+        bool is_parallel(size_t words)
+        {
+            return words >= threshold && words > chunk_words && get_threads() > 1;
+        }
+
+        void run_chunks(size_t words, void (*task)(const void *context, size_t first, size_t last), const void *context)
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                task(context, 0, words);
+                return;
+            }
+
+            if (!pool || pool->get_threads() != get_threads())
+                pool = std::make_unique<Thread_pool>(get_threads());
+            pool->run(words, task, context);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file triple_parallel.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий многопоточное выполнение операций над широкими векторами
+ * @version 0.1
+ * @date 2025-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_PARALLEL_H
+#define TRIPLE_PARALLEL_H
+
+#include <cstddef>
+
+namespace Triple_signal
+{
+    namespace parallel
+    {
+        /**
+         * @brief Кратность границ кусков в словах: 8 слов uint64_t - одна строка кэша
+         *
+         * Плоскости векторов выровнены по 64 байтам, поэтому соседние потоки
+         * никогда не пишут в одну строку кэша
+         */
+        constexpr size_t chunk_words = 8;
+
+        /**
+         * @brief Задает число потоков (включая вызывающий)
+         *
+         * @param threads Число потоков, 0 - по числу ядер процессора
+         */
+        void set_threads(size_t threads);
+
+        /**
+         * @brief Число потоков, на которое делится работа
+         *
+         * @return size_t
+         */
+        size_t get_threads();
+
+        /**
+         * @brief Задает порог в словах плоскости, начиная с которого операции выполняются параллельно
+         *
+         * @param words Порог, по умолчанию 16384 слова (1M сигналов)
+         */
+        void set_threshold(size_t words);
+
+        /**
+         * @brief Порог параллельного выполнения в словах плоскости
+         *
+         * @return size_t
+         */
+        size_t get_threshold();
+
+        /**
+         * @brief Будет ли операция над words словами выполняться параллельно
+         *
+         * @return true Потоков больше одного и words не меньше порога
+         * @return false Иначе
+         */
+        bool is_parallel(size_t words);
+
+        /**
+         * @brief Делит [0, words) на куски, кратные chunk_words, и выполняет task над ними в пуле потоков
+         *
+         * Возвращается после завершения всех кусков. Вложенный или одновременный
+         * вызов из другого потока выполняется последовательно в вызывающем потоке.
+         *
+         * @param words Число слов
+         * @param task Функция над куском [first, last)
+         * @param context Аргумент task
+         */
+        void run_chunks(size_t words, void (*task)(const void *context, size_t first, size_t last), const void *context);
+
+        /**
+         * @brief Выполняет function(first, last) над кусками [0, words)
+         *
+         * Ниже порога - один вызов function(0, words) без обращения к пулу
+         *
+         * @tparam F Вызываемый объект void(size_t, size_t)
+         */
+        template <typename F>
+        void for_chunks(size_t words, const F &function)
+        {
+            if (!is_parallel(words))
+            {
+                function(size_t(0), words);
+                return;
+            }
+
+            run_chunks(words, [](const void *context, size_t first, size_t last)
+                       { (*static_cast<const F *>(context))(first, last); }, &function);
+        }
+    }
+}
+
+#endif
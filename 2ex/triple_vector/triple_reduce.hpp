@@ -0,0 +1,175 @@
+/**
+ * @file triple_reduce.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий свертки и подсчет сигналов векторов троичных сигналов
+ * @version 0.1
+ * @date 2025-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_REDUCE_H
+#define TRIPLE_REDUCE_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "../triple_signal/triple_signal.hpp"
+#include "triple_expr.hpp"
+#include "triple_parallel.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Вызывает function(bit, known, value, mask) для каждого слова выражения
+     *
+     * bit - номер первого сигнала слова, mask - биты слова, попадающие в размер выражения;
+     * биты known/value за пределами mask обнулены.
+     * Обход прекращается, если function вернула false.
+     *
+     * @return true Обход дошел до конца
+     * @return false Обход прерван
+     */
+    template <typename E, typename F>
+    bool for_each_word(const Triple_expr<E> &expr, F &&function)
+    {
+        size_t size = expr.get_size();
+        for (size_t bit = 0; bit < size; bit += 64)
+        {
+            uint64_t known, value;
+            expr.load(bit, known, value);
+            uint64_t mask = size - bit >= 64 ? ~uint64_t(0) : (uint64_t(1) << (size - bit)) - 1;
+            if (!function(bit, known & mask, value & mask, mask))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Троичное И всех сигналов
+     *
+     * ZERO, если есть хотя бы один ZERO; иначе UNKNOWN, если есть неопределенный; иначе ONE.
+     * Для пустого вектора - ONE (нейтральный элемент И)
+     *
+     * @return Triple_signal
+     */
+    template <typename E>
+    Triple_signal and_reduce(const Triple_expr<E> &expr)
+    {
+        bool unknown = false;
+        bool zero = !for_each_word(expr, [&](size_t, uint64_t known, uint64_t value, uint64_t mask)
+                                   {
+            unknown |= known != mask;
+            return (known & ~value) == 0; });
+
+        if (zero)
+            return Triple_signal(ZERO);
+        return Triple_signal(unknown ? UNKNOWN : ONE);
+    }
+
+    /**
+     * @brief Троичное ИЛИ всех сигналов
+     *
+     * ONE, если есть хотя бы один ONE; иначе UNKNOWN, если есть неопределенный; иначе ZERO.
+     * Для пустого вектора - ZERO (нейтральный элемент ИЛИ)
+     *
+     * @return Triple_signal
+     */
+    template <typename E>
+    Triple_signal or_reduce(const Triple_expr<E> &expr)
+    {
+        bool unknown = false;
+        bool one = !for_each_word(expr, [&](size_t, uint64_t known, uint64_t value, uint64_t mask)
+                                  {
+            unknown |= known != mask;
+            return value == 0; });
+
+        if (one)
+            return Triple_signal(ONE);
+        return Triple_signal(unknown ? UNKNOWN : ZERO);
+    }
+
+    /**
+     * @brief Троичное исключающее ИЛИ всех сигналов
+     *
+     * UNKNOWN, если есть неопределенный сигнал, иначе четность числа ONE.
+     * Для пустого вектора - ZERO
+     *
+     * @return Triple_signal
+     */
+    template <typename E>
+    Triple_signal xor_reduce(const Triple_expr<E> &expr)
+    {
+        uint64_t parity = 0;
+        bool known_all = for_each_word(expr, [&](size_t, uint64_t known, uint64_t value, uint64_t mask)
+                                       {
+            parity ^= value;
+            return known == mask; });
+
+        if (!known_all)
+            return Triple_signal(UNKNOWN);
+        return Triple_signal(std::popcount(parity) % 2 ? ONE : ZERO);
+    }
+
+    /**
+     * @brief Количество сигналов с заданным значением
+     *
+     * Считается через popcount по плоскостям, широкие выражения - в пуле потоков
+     *
+     * @param expr Выражение или вектор
+     * @param signal Искомое значение
+     * @return size_t
+     */
+    template <typename E>
+    size_t count(const Triple_expr<E> &expr, Signal signal)
+    {
+        size_t size = expr.get_size();
+        std::atomic<size_t> total{0};
+
+        parallel::for_chunks((size + 63) / 64, [&](size_t first, size_t last)
+                             {
+            size_t local = 0;
+            for (size_t word = first; word < last; word++)
+            {
+                size_t bit = word * 64;
+                uint64_t known, value;
+                expr.load(bit, known, value);
+                if (size - bit < 64)
+                {
+                    uint64_t mask = (uint64_t(1) << (size - bit)) - 1;
+                    known &= mask;
+                    value &= mask;
+                }
+                local += std::popcount(signal == ONE ? value : signal == ZERO ? known & ~value : known);
+            }
+            total.fetch_add(local, std::memory_order_relaxed); });
+
+        return signal == UNKNOWN ? size - total : total.load();
+    }
+
+    /**
+     * @brief Номер первого неопределенного сигнала
+     *
+     * @return size_t Номер сигнала или get_size(), если все сигналы определены
+     */
+    template <typename E>
+    size_t first_unknown(const Triple_expr<E> &expr)
+    {
+        size_t size = expr.get_size();
+        size_t result = size;
+        for_each_word(expr, [&](size_t bit, uint64_t known, uint64_t, uint64_t mask)
+                      {
+            uint64_t unknown = ~known & mask;
+            if (unknown != 0)
+            {
+                result = bit + std::countr_zero(unknown);
+                return false;
+            }
+            return true; });
+        return result;
+    }
+}
+
+#endif
@@ -1,7 +1,290 @@
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <new>
+
 #include "triple_vector.hpp"
+#include "triple_kernels.hpp"
+#include "triple_parallel.hpp"
 
 namespace Triple_signal
 {
+    namespace
+    {
+        bool fits_inline(size_t size)
+        {
+            return size != 0 && size <= Triple_vector::inline_bits;
+        }
+
+        // Число слов, отводимое под одну плоскость. В куче - кратно кэш-линии, чтобы плоскость value была выровнена
+        size_t plane_stride(size_t size)
+        {
+            if (fits_inline(size))
+                return Triple_vector::inline_words;
+
+            constexpr size_t line_words = Triple_vector::plane_alignment / sizeof(uint64_t);
+            return (Triple_vector::word_count(size) + line_words - 1) / line_words * line_words;
+        }
+
+        uint64_t tail_mask(size_t size)
+        {
+            size_t rest = size % Triple_vector::word_bits;
+            return rest == 0 ? ~uint64_t(0) : (uint64_t(1) << rest) - 1;
+        }
+
+        /**
+         * @brief Заголовок буфера в куче, занимает первую кэш-линию перед плоскостью known
+         *
+         * hash == 0 означает, что хэш еще не вычислен.
+         * resource и bytes нужны, чтобы вернуть блок тому ресурсу, из которого он выделен
+         */
+        struct Shared_header
+        {
+            std::atomic<size_t> references;
+            std::atomic<uint64_t> hash;
+            std::pmr::memory_resource *resource;
+            size_t bytes;
+        };
+
+        static_assert(sizeof(Shared_header) <= Triple_vector::plane_alignment);
+
+        Shared_header *header_of(const uint64_t *known)
+        {
+            return reinterpret_cast<Shared_header *>(
+                reinterpret_cast<char *>(const_cast<uint64_t *>(known)) - Triple_vector::plane_alignment);
+        }
+
+        uint64_t mix(uint64_t hash, uint64_t word)
+        {
+            hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 29);
+        }
+
+        // Четыре независимые цепочки, чтобы умножения шли параллельно
+        uint64_t hash_plane(const uint64_t *plane, size_t words, uint64_t seed)
+        {
+            uint64_t lanes[4] = {seed, seed + 1, seed + 2, seed + 3};
+            size_t i = 0;
+            for (; i + 4 <= words; i += 4)
+            {
+                for (size_t lane = 0; lane < 4; lane++)
+                    lanes[lane] = mix(lanes[lane], plane[i + lane]);
+            }
+            for (; i < words; i++)
+                lanes[0] = mix(lanes[0], plane[i]);
+            return mix(mix(lanes[0], lanes[1]), mix(lanes[2], lanes[3]));
+        }
+    }
+
+    void Triple_vector::allocate(size_t capacity)
+    {
+        size_t stride = plane_stride(capacity);
+        if (stride == 0)
+        {
+            known = value = nullptr;
+            return;
+        }
+
+        if (fits_inline(capacity))
+            known = inline_planes.data();
+        else
+        {
+            size_t bytes = plane_alignment + 2 * stride * sizeof(uint64_t);
+            char *block = static_cast<char *>(resource->allocate(bytes, plane_alignment));
+            Shared_header *header = new (block) Shared_header;
+            header->references.store(1, std::memory_order_relaxed);
+            header->hash.store(0, std::memory_order_relaxed);
+            header->resource = resource;
+            header->bytes = bytes;
+            known = reinterpret_cast<uint64_t *>(block + plane_alignment);
+        }
+
+        std::fill_n(known, 2 * stride, 0);
+        value = known + stride;
+    }
+
+    void Triple_vector::release()
+    {
+        if (known != nullptr && !is_inline())
+        {
+            Shared_header *header = header_of(known);
+            if (header->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::pmr::memory_resource *owner = header->resource;
+                size_t bytes = header->bytes;
+                header->~Shared_header();
+                owner->deallocate(header, bytes, plane_alignment);
+            }
+        }
+        known = value = nullptr;
+    }
+
+    void Triple_vector::copy_from(const Triple_vector &vector, size_t capacity)
+    {
+        size_t words = word_count(vector.size);
+        size = vector.size;
+        allocate(capacity);
+        std::copy_n(vector.known, words, known);
+        std::copy_n(vector.value, words, value);
+    }
+
+    bool Triple_vector::can_overwrite(size_t size) const
+    {
+        return known != nullptr && !is_inline() && get_use_count() == 1 && size <= get_capacity();
+    }
+
+    void Triple_vector::detach()
+    {
+        if (known == nullptr || is_inline())
+            return;
+
+        if (header_of(known)->references.load(std::memory_order_acquire) != 1)
+        {
+            Triple_vector copy(resource);
+            copy.copy_from(*this, get_capacity());
+
+            release();
+            take(copy);
+        }
+        header_of(known)->hash.store(0, std::memory_order_relaxed);
+    }
+
+    void Triple_vector::take(Triple_vector &vector) noexcept
+    {
+        resource = vector.resource;
+        size = vector.size;
+        if (vector.is_inline())
+        {
+            inline_planes = vector.inline_planes;
+            known = inline_planes.data();
+            value = known + inline_words;
+        }
+        else
+        {
+            known = vector.known;
+            value = vector.value;
+        }
+
+        vector.known = vector.value = nullptr;
+        vector.size = 0;
+    }
+
+    void Triple_vector::set(size_t index, Signal signal)
+    {
+        detach();
+
+        uint64_t bit = uint64_t(1) << (index % word_bits);
+        size_t word = index / word_bits;
+
+        if (signal == UNKNOWN)
+            known[word] &= ~bit;
+        else
+            known[word] |= bit;
+
+        if (signal == ONE)
+            value[word] |= bit;
+        else
+            value[word] &= ~bit;
+    }
+
+    void Triple_vector::clear_tail()
+    {
+        size_t words = word_count(size);
+        if (words != 0)
+        {
+            known[words - 1] &= tail_mask(size);
+            value[words - 1] &= tail_mask(size);
+        }
+    }
+
+    void Triple_vector::clear_signals()
+    {
+        if (known != nullptr && !is_inline() && get_use_count() != 1)
+            release();
+        else if (known != nullptr)
+        {
+            detach();
+            std::fill_n(known, word_count(size), 0);
+            std::fill_n(value, word_count(size), 0);
+        }
+        size = 0;
+    }
+
+    size_t Triple_vector::parse_append(const char *text, size_t length)
+    {
+        if (size + length > get_capacity())
+        {
+            Triple_vector grown(resource);
+            grown.copy_from(*this, std::max(size + length, 2 * get_capacity()));
+            *this = std::move(grown);
+        }
+        else
+            detach();
+
+        size_t first = size / word_bits;
+        size_t parsed = kernels::parse_signals(text, length, known + first, value + first);
+        if (parsed != length)
+        {
+            // Слово с недопустимым символом и следующие могли быть записаны частично: обнуляются и неполное слово разбирается заново
+            size_t word = first + parsed / word_bits;
+            std::fill(known + word, known + first + word_count(length), 0);
+            std::fill(value + word, value + first + word_count(length), 0);
+            kernels::parse_signals(text + parsed / word_bits * word_bits, parsed % word_bits, known + word, value + word);
+        }
+
+        size += parsed;
+        return parsed;
+    }
+
+    Signal Triple_vector::get(size_t index) const
+    {
+        uint64_t bit = uint64_t(1) << (index % word_bits);
+        size_t word = index / word_bits;
+
+        if (!(known[word] & bit))
+            return UNKNOWN;
+        return (value[word] & bit) ? ONE : ZERO;
+    }
+
+    Triple_vector::reference &Triple_vector::reference::operator=(const Triple_signal &signal)
+    {
+        vector->set(index, signal.get_signal());
+        return *this;
+    }
+
+    Triple_vector::reference &Triple_vector::reference::operator=(const reference &other)
+    {
+        vector->set(index, other.get_signal());
+        return *this;
+    }
+
+    Triple_vector::reference::operator Triple_signal() const
+    {
+        return Triple_signal(get_signal());
+    }
+
+    Signal Triple_vector::reference::get_signal() const
+    {
+        return vector->get(index);
+    }
+
+    char Triple_vector::reference::get_signal_char() const
+    {
+        return Triple_signal(get_signal()).get_signal_char();
+    }
+
+    bool Triple_vector::reference::operator==(const Triple_signal &signal) const
+    {
+        return get_signal() == signal.get_signal();
+    }
+
+    std::ostream &operator<<(std::ostream &out, const Triple_vector::reference &signal)
+    {
+        out << signal.get_signal_char();
+        return out;
+    }
+
     Triple_vector::Triple_vector(int cnt_unknown)
     {
         if (cnt_unknown <= 0)
@@ -10,184 +293,344 @@ namespace Triple_signal
         }
 
         size = cnt_unknown;
-        array = new Triple_signal[size]{};
+        allocate(size);
     }
 
-    Triple_vector::Triple_vector(std::string signals)
+    Triple_vector::Triple_vector(std::string_view signals)
     {
-        size = signals.size();
-        array = new Triple_signal[size]{};
-
-        size_t index = 0;
-        std::for_each_n(this->array, this->size, [&](Triple_signal &signal)
-                        { signal.set_signal(signals[index++]); });
+        set_signals(signals);
     }
 
-    Triple_vector::Triple_vector(const Triple_vector &vector) noexcept
+    Triple_vector::Triple_vector(const Triple_vector &vector) : Triple_vector(vector, std::pmr::get_default_resource()) {}
+
+    Triple_vector::Triple_vector(const Triple_vector &vector, std::pmr::memory_resource *resource) : resource(resource)
     {
         size = vector.size;
-        array = new Triple_signal[size]{};
+        if (vector.known == nullptr || vector.is_inline() || *header_of(vector.known)->resource != *resource)
+        {
+            copy_from(vector, size);
+            return;
+        }
 
-        std::copy_n(vector.array, vector.size, array);
+        known = vector.known;
+        value = vector.value;
+        header_of(known)->references.fetch_add(1, std::memory_order_relaxed);
     }
 
-    Triple_vector::Triple_vector(Triple_vector &&vector) noexcept : array(vector.array), size(vector.size)
+    Triple_vector::Triple_vector(Triple_vector &&vector) noexcept
     {
-        vector.array = nullptr;
-        vector.size = 0;
+        take(vector);
     }
 
-    void Triple_vector::set_signals(std::string signals)
+    void Triple_vector::set_signals(std::string_view signals)
     {
-        delete[] array;
+        Triple_vector result(resource);
+        result.size = signals.size();
+        result.allocate(result.size);
 
-        size = signals.size();
-        array = new Triple_signal[size]{};
+        if (kernels::parse_signals(signals.data(), signals.size(), result.known, result.value) != signals.size())
+        {
+            throw std::invalid_argument("invalid signal");
+        }
 
-        size_t index = 0;
-        std::for_each_n(this->array, this->size, [&](Triple_signal &signal)
-                        { signal.set_signal(signals[index++]); });
+        *this = std::move(result);
     }
 
     std::string Triple_vector::get_signals() const
     {
-        std::string result;
-        std::for_each_n(this->array, this->size, [&result](Triple_signal &signal)
-                        { result += signal.get_signal_char(); });
+        std::string result(size, 'X');
+        kernels::format_signals(known, value, size, result.data());
         return result;
     }
 
     Triple_signal *Triple_vector::get_signals(int &size) const
     {
         size = this->size;
-        return this->array;
+
+        Triple_signal *result = new Triple_signal[this->size]{};
+        for (size_t i = 0; i < this->size; i++)
+        {
+            result[i].set_signal(get(i));
+        }
+        return result;
+    }
+
+    size_t Triple_vector::get_size() const
+    {
+        return size;
     }
 
     bool Triple_vector::is_known() const
     {
-        bool flag = true;
-        std::for_each_n(array, size, [&flag](const Triple_signal &signal)
-                        {
-            if(signal.get_signal() == UNKNOWN){
-                flag = false;
-                return;
-            } });
+        size_t words = word_count(size);
+        if (words == 0)
+            return true;
 
-        return flag;
+        return kernels::all_ones(known, words - 1) && known[words - 1] == tail_mask(size);
     }
 
     void Triple_vector::input(std::istream &in)
     {
-        std::string input;
-        in >> input;
-        this->set_signals(input);
+        in >> *this;
     }
 
     void Triple_vector::print(std::ostream &out)
     {
-        out << (this->get_signals());
+        out << *this;
     }
 
     Triple_vector &Triple_vector::operator=(const Triple_vector &vector)
     {
-        if (this != &vector)
-        {
-            delete[] array;
+        if (this == &vector)
+            return *this;
 
-            array = nullptr;
-            if ((size = vector.size) != 0)
+        // Буфер из чужого ресурса (например, временный из арены цикла) не разделяется,
+        // а копируется в свой буфер без выделения памяти, если тот единоличный и вмещает сигналы
+        bool foreign = vector.known != nullptr && !vector.is_inline() && *header_of(vector.known)->resource != *resource;
+        if (foreign && known != nullptr && !is_inline() && get_use_count() == 1 && get_capacity() >= vector.size)
+        {
+            size_t words = word_count(vector.size);
+            size_t old_words = word_count(size);
+            detach();
+            std::copy_n(vector.known, words, known);
+            std::copy_n(vector.value, words, value);
+            if (old_words > words)
             {
-                array = new Triple_signal[size]{};
-                std::copy_n(vector.array, vector.size, array);
+                std::fill(known + words, known + old_words, 0);
+                std::fill(value + words, value + old_words, 0);
             }
+            size = vector.size;
+            return *this;
         }
+
+        Triple_vector copy(vector, resource);
+        release();
+        take(copy);
         return *this;
     }
 
-    Triple_vector &Triple_vector::operator=(Triple_vector &&vector) noexcept
+    Triple_vector &Triple_vector::operator=(Triple_vector &&vector)
     {
-        std::swap(this->array, vector.array);
-        std::swap(this->size, vector.size);
+        if (this == &vector)
+            return *this;
+
+        // Буфер из другого ресурса (например, из арены, которую сбросят в конце такта) не забирается,
+        // иначе вектор пережил бы свою память: сигналы копируются в собственный ресурс
+        if (*vector.resource != *resource)
+            return *this = static_cast<const Triple_vector &>(vector);
+
+        release();
+        take(vector);
         return *this;
     }
 
     bool Triple_vector::operator==(const Triple_vector &vector_2) const
     {
-        return this->get_signals() == vector_2.get_signals();
+        if (size != vector_2.size)
+            return false;
+        if (size == 0 || known == vector_2.known)
+            return true;
+
+        if (!is_inline() && !vector_2.is_inline())
+        {
+            uint64_t hash_1 = header_of(known)->hash.load(std::memory_order_relaxed);
+            uint64_t hash_2 = header_of(vector_2.known)->hash.load(std::memory_order_relaxed);
+            if (hash_1 != 0 && hash_2 != 0 && hash_1 != hash_2)
+                return false;
+        }
+
+        // Емкости векторов могут различаться, поэтому плоскости сравниваются по отдельности
+        std::atomic<bool> equal{true};
+        parallel::for_chunks(word_count(size), [&](size_t first, size_t last)
+                             {
+            size_t bytes = (last - first) * sizeof(uint64_t);
+            if (equal.load(std::memory_order_relaxed) &&
+                (std::memcmp(known + first, vector_2.known + first, bytes) != 0 ||
+                 std::memcmp(value + first, vector_2.value + first, bytes) != 0))
+                equal.store(false, std::memory_order_relaxed); });
+        return equal;
     }
 
-    bool Triple_vector::operator!=(const Triple_vector &vector_2) const
+    void Triple_vector::push_back(const Triple_signal &signal)
     {
-        return this->get_signals() != vector_2.get_signals();
+        append(Triple_single(signal));
     }
 
-    Triple_vector Triple_vector::operator|(const Triple_vector &vector_2) const
+    Triple_vector &Triple_vector::operator+=(const Triple_signal &signal)
     {
-        int size = std::min(this->size, vector_2.size);
+        return append(Triple_single(signal));
+    }
 
-        std::string new_signals;
-        Triple_signal *signals_1 = this->array;
-        Triple_signal *signals_2 = vector_2.array;
+    void Triple_vector::reserve(size_t capacity)
+    {
+        if (capacity > get_capacity())
+        {
+            Triple_vector grown(resource);
+            grown.copy_from(*this, capacity);
+            *this = std::move(grown);
+        }
+    }
 
-        int i = 0;
-        std::for_each_n(signals_1, size, [&](const Triple_signal &signal)
-                        { new_signals += (signal || (signals_2[i++])).get_signal_char(); });
-        return Triple_vector(new_signals);
+    size_t Triple_vector::get_capacity() const
+    {
+        return get_stride() * word_bits;
     }
 
-    Triple_vector Triple_vector::operator&(const Triple_vector &vector_2) const
+    void Triple_vector::shrink_to_fit()
     {
-        int size = std::min(this->size, vector_2.size);
+        if (get_stride() != plane_stride(size))
+        {
+            Triple_vector shrunk(resource);
+            shrunk.copy_from(*this, size);
+            *this = std::move(shrunk);
+        }
+    }
 
-        std::string new_signals;
-        Triple_signal *signals_1 = this->array;
-        Triple_signal *signals_2 = vector_2.array;
+    uint64_t Triple_vector::get_hash() const
+    {
+        if (known == nullptr || is_inline())
+        {
+            size_t words = word_count(size);
+            return hash_plane(value, words, hash_plane(known, words, size)) | 1;
+        }
 
-        int i = 0;
-        std::for_each_n(signals_1, size, [&](const Triple_signal &signal)
-                        { new_signals += (signal && (signals_2[i++])).get_signal_char(); });
-        return Triple_vector(new_signals);
+        Shared_header *header = header_of(known);
+        uint64_t hash = header->hash.load(std::memory_order_relaxed);
+        if (hash == 0)
+        {
+            size_t words = word_count(size);
+            // Младший бит всегда 1, поэтому вычисленный хэш не совпадает с признаком "не вычислен"
+            hash = hash_plane(value, words, hash_plane(known, words, size)) | 1;
+            header->hash.store(hash, std::memory_order_relaxed);
+        }
+        return hash;
     }
 
-    Triple_vector Triple_vector::operator~() const
+    size_t Triple_vector::get_use_count() const
     {
-        int size = this->size;
+        if (known == nullptr || is_inline())
+            return 1;
+        return header_of(known)->references.load(std::memory_order_relaxed);
+    }
 
-        std::string new_signals;
-        Triple_signal *signals_1 = this->array;
+    std::pmr::memory_resource *Triple_vector::get_resource() const
+    {
+        return resource;
+    }
 
-        std::for_each_n(signals_1, size, [&new_signals](const Triple_signal &signal)
-                        { new_signals += (!signal).get_signal_char(); });
-        return Triple_vector(new_signals);
+    bool Triple_vector::operator!=(const Triple_vector &vector_2) const
+    {
+        return !(*this == vector_2);
     }
 
-    Triple_vector Triple_vector::operator+(const Triple_vector &vector_2) const
+    void evaluate_planes(const Triple_and<Triple_vector, Triple_vector> &expr, uint64_t *known, uint64_t *value, size_t words)
     {
-        return Triple_vector(this->get_signals() + vector_2.get_signals());
+        const Triple_vector &left = expr.left();
+        const Triple_vector &right = expr.right();
+        parallel::for_chunks(words, [&](size_t first, size_t last)
+                             { kernels::and_planes(left.get_known() + first, left.get_value() + first,
+                                                   right.get_known() + first, right.get_value() + first,
+                                                   known + first, value + first, last - first); });
     }
 
-    Triple_vector Triple_vector::operator+(const Triple_signal &signal) const
+    void evaluate_planes(const Triple_or<Triple_vector, Triple_vector> &expr, uint64_t *known, uint64_t *value, size_t words)
     {
-        return Triple_vector(this->get_signals() + signal.get_signal_char());
+        const Triple_vector &left = expr.left();
+        const Triple_vector &right = expr.right();
+        parallel::for_chunks(words, [&](size_t first, size_t last)
+                             { kernels::or_planes(left.get_known() + first, left.get_value() + first,
+                                                  right.get_known() + first, right.get_value() + first,
+                                                  known + first, value + first, last - first); });
+    }
+
+    void evaluate_planes(const Triple_not<Triple_vector> &expr, uint64_t *known, uint64_t *value, size_t words)
+    {
+        const Triple_vector &operand = expr.operand();
+        parallel::for_chunks(words, [&](size_t first, size_t last)
+                             { kernels::not_planes(operand.get_known() + first, operand.get_value() + first,
+                                                   known + first, value + first, last - first); });
     }
 
     std::istream &operator>>(std::istream &in, Triple_vector &vector)
     {
-        std::string input;
-        in >> input;
-        vector.set_signals(input);
+        vector.clear_signals();
+
+        std::istream::sentry sentry(in);
+        if (!sentry)
+            return in;
+
+        const std::ctype<char> &ctype = std::use_facet<std::ctype<char>>(in.getloc());
+        std::streambuf *buffer = in.rdbuf();
+        std::ios_base::iostate state = std::ios_base::goodbit;
+        size_t limit = in.width() > 0 ? static_cast<size_t>(in.width()) : std::numeric_limits<size_t>::max();
+
+        // Блок кратен word_bits, поэтому каждый следующий блок разбирается с начала слова
+        char block[format_block];
+        size_t filled = 0;
+        size_t extracted = 0;
+        bool valid = true;
+
+        for (int symbol = buffer->sgetc(); extracted < limit; symbol = buffer->snextc())
+        {
+            if (std::char_traits<char>::eq_int_type(symbol, std::char_traits<char>::eof()))
+            {
+                state |= std::ios_base::eofbit;
+                break;
+            }
+
+            char character = std::char_traits<char>::to_char_type(symbol);
+            if (ctype.is(std::ctype_base::space, character))
+                break;
+
+            block[filled++] = character;
+            extracted++;
+            if (filled == format_block)
+            {
+                valid = valid && vector.parse_append(block, filled) == filled;
+                filled = 0;
+            }
+        }
+        if (filled != 0)
+            valid = valid && vector.parse_append(block, filled) == filled;
+
+        in.width(0);
+        if (extracted == 0)
+            state |= std::ios_base::failbit;
+        in.setstate(state);
+
+        if (!valid)
+        {
+            vector.clear_signals();
+            throw std::invalid_argument("invalid signal");
+        }
 
         return in;
     }
 
-    std::ostream &operator<<(std::ostream &out, const Triple_vector &vector)
+    std::from_chars_result from_chars(const char *first, const char *last, Triple_vector &vector)
     {
-        out << vector.get_signals();
+        if (first == last || (*first != '0' && *first != '1' && *first != 'x' && *first != 'X'))
+            return {first, std::errc::invalid_argument};
 
-        return out;
+        // Разбор блоками с начала слова до первого недопустимого символа за один проход
+        vector.clear_signals();
+        const char *block = first;
+        while (true)
+        {
+            size_t length = std::min<size_t>(format_block, last - block);
+            size_t parsed = vector.parse_append(block, length);
+            block += parsed;
+            if (parsed != length || block == last)
+                return {block, std::errc()};
+        }
+    }
+
+    std::ostream &operator<<(std::ostream &out, const Triple_vector &vector)
+    {
+        return write_signals(out, vector);
     }
 
-    Triple_signal &Triple_vector::operator[](size_t index)
+    Triple_vector::reference Triple_vector::operator[](size_t index)
     {
         if (index >= size)
         {
@@ -195,44 +638,32 @@ namespace Triple_signal
                                     " out of range for vector of size " +
                                     std::to_string(size));
         }
-        return array[index];
+        return reference(this, index);
     }
 
-    Triple_vector Triple_vector::operator[](const std::pair<size_t, size_t> &indices) const
+    Triple_signal Triple_vector::operator[](size_t index) const
     {
-        size_t start = indices.first;
-        size_t end = indices.second;
-
-        if (start >= size || end >= size)
+        if (index >= size)
         {
-            throw std::out_of_range("Indices out of range: [" +
-                                    std::to_string(start) + ", " +
-                                    std::to_string(end) + "] for size " +
+            throw std::out_of_range("Index " + std::to_string(index) +
+                                    " out of range for vector of size " +
                                     std::to_string(size));
         }
+        return Triple_signal(get(index));
+    }
 
-        if (start > end)
-        {
-            throw std::invalid_argument("Start index " + std::to_string(start) +
-                                        " cannot be greater than end index " +
-                                        std::to_string(end));
-        }
-
-        std::string substr = this->get_signals().substr(start, start + end - 1);
+    Triple_vector_view Triple_vector::operator[](const std::pair<size_t, size_t> &indices) const
+    {
+        return view()[indices];
+    }
 
-        return Triple_vector(substr);
+    Triple_vector_view Triple_vector::view() const
+    {
+        return Triple_vector_view(known, value, 0, size);
     }
 
     bool Triple_vector::operator!() const
     {
-        bool flag = true;
-        std::for_each_n(array, size, [&flag](const Triple_signal &signal)
-                        {
-            if(signal.get_signal() == UNKNOWN){
-                flag = false;
-                return;
-            } });
-
-        return flag;
+        return is_known();
     }
 }
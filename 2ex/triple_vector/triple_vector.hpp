@@ -13,22 +13,293 @@
 
 #include <iostream>
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 #include "../triple_signal/triple_signal.hpp"
+#include "triple_expr.hpp"
+#include "triple_format.hpp"
+#include "triple_vector_view.hpp"
+
+#ifndef TRIPLE_VECTOR_INLINE_BITS
+/**
+ * @brief Максимальное число сигналов, хранимых внутри объекта Triple_vector без выделения памяти
+ *
+ * Задается при сборке (опция CMake TRIPLE_VECTOR_INLINE_BITS), 0 отключает встроенный буфер
+ */
+#define TRIPLE_VECTOR_INLINE_BITS 64
+#endif
 
 namespace Triple_signal
 {
     /**
      * @brief Класс представляющий вектор троичных сигналов
      *
+     * Сигналы хранятся упакованными в две битовые плоскости по 64 сигнала в слове:
+     * known (1 - сигнал определен) и value (1 - сигнал равен ONE).
+     * ZERO = (1, 0), ONE = (1, 1), UNKNOWN = (0, 0).
+     * Биты за пределами размера вектора всегда нулевые.
+     *
+     * Вектор является листом ленивых выражений Triple_expr (см. triple_expr.hpp).
+     *
+     * Векторы до inline_bits сигналов хранятся во встроенном буфере объекта и не выделяют память,
+     * более длинные - в выровненном буфере в куче.
+     *
+     * Буфер в куче разделяется копиями (копирование при записи): копия только увеличивает
+     * атомарный счетчик ссылок, а изменение сигнала отделяет собственную копию плоскостей.
+     * В заголовке буфера кэшируется хэш содержимого (get_hash), которым пользуются
+     * operator== и таблица Triple_intern_table.
+     *
+     * Буферы в куче выделяются из ресурса памяти std::pmr::memory_resource вектора
+     * (по умолчанию std::pmr::get_default_resource()). Все промежуточные буферы операций
+     * берутся из того же ресурса, поэтому векторы на Triple_cycle_arena не обращаются к malloc/free.
+     * Копия, как у контейнеров std::pmr, получает ресурс по умолчанию и разделяет буфер,
+     * только если он выделен из того же ресурса. Перемещающий конструктор передает ресурс
+     * вместе с буфером, а перемещающее присваивание забирает буфер только из равного ресурса.
      */
-    class Triple_vector
+    class Triple_vector : public Triple_expr<Triple_vector>
     {
+    public:
+        /**
+         * @brief Количество сигналов в одном слове плоскости
+         *
+         */
+        static constexpr size_t word_bits = 64;
+
+        /**
+         * @brief Максимальное число сигналов во встроенном буфере
+         *
+         */
+        static constexpr size_t inline_bits = TRIPLE_VECTOR_INLINE_BITS;
+
+        /**
+         * @brief Число слов одной плоскости во встроенном буфере
+         *
+         */
+        static constexpr size_t inline_words = (inline_bits + word_bits - 1) / word_bits;
+
+    private:
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource();
         size_t size = 0;
-        Triple_signal *array = nullptr;
+        uint64_t *known = nullptr;
+        uint64_t *value = nullptr;
+        std::array<uint64_t, 2 * inline_words> inline_planes;
+
+        /**
+         * @brief Выделяет обнуленные плоскости не меньше чем под capacity сигналов
+         *
+         * Плоскости выровнены по кэш-линии, чтобы ядра triple_kernels читали их целыми векторами
+         */
+        void allocate(size_t capacity);
+
+        /**
+         * @brief Копирует сигналы другого вектора в новые плоскости под capacity сигналов
+         *
+         */
+        void copy_from(const Triple_vector &vector, size_t capacity);
+
+        /**
+         * @brief Расстояние между плоскостями known и value в словах
+         *
+         */
+        size_t get_stride() const
+        {
+            return value - known;
+        }
+
+        /**
+         * @brief Освобождает плоскости
+         *
+         */
+        void release();
+
+        /**
+         * @brief Делает буфер в куче единоличным перед изменением и сбрасывает кэш хэша
+         *
+         */
+        void detach();
+
+        /**
+         * @brief Забирает плоскости и ресурс памяти другого вектора, оставляя его пустым
+         *
+         * Встроенный буфер копируется, буфер в куче передается без копирования
+         */
+        void take(Triple_vector &vector) noexcept;
+
+        /**
+         * @brief Можно ли записать size сигналов поверх собственного буфера
+         *
+         * Буфер в куче должен быть единоличным и вмещать size сигналов
+         */
+        bool can_overwrite(size_t size) const;
+
+        /**
+         * @brief Хранятся ли плоскости во встроенном буфере
+         *
+         */
+        bool is_inline() const
+        {
+            return known == inline_planes.data();
+        }
+
+        /**
+         * @brief Устанавливает значение сигнала без проверки индекса
+         *
+         */
+        void set(size_t index, Signal signal);
+
+        /**
+         * @brief Возвращает значение сигнала без проверки индекса
+         *
+         */
+        Signal get(size_t index) const;
+
+        /**
+         * @brief Обнуляет биты плоскостей за пределами размера вектора
+         *
+         */
+        void clear_tail();
+
+        /**
+         * @brief Делает вектор пустым, сохраняя единоличный буфер для повторного разбора
+         *
+         */
+        void clear_signals();
+
+        /**
+         * @brief Дописывает наибольший префикс из символов 0/1/x/X в конец вектора, размер которого кратен word_bits
+         *
+         * Емкость растет геометрически, поэтому разбор блоками стоит амортизированно O(1) на сигнал
+         *
+         * @return size_t Длина дописанного префикса: length, если строка корректна
+         */
+        size_t parse_append(const char *text, size_t length);
+
+        /**
+         * @brief Дописывает count сигналов выражения в конец, емкость уже достаточна
+         *
+         * Биты за концом вектора нулевые, поэтому слова выражения вписываются через ИЛИ со сдвигом
+         */
+        template <typename E>
+        void append_unchecked(const E &expr, size_t count)
+        {
+            size_t first = size / word_bits;
+            size_t shift = size % word_bits;
+            size_t stride = get_stride();
+
+            for (size_t bit = 0; bit < count; bit += word_bits)
+            {
+                uint64_t known_word, value_word;
+                expr.load(bit, known_word, value_word);
+                if (count - bit < word_bits)
+                {
+                    uint64_t mask = (uint64_t(1) << (count - bit)) - 1;
+                    known_word &= mask;
+                    value_word &= mask;
+                }
+
+                size_t word = first + bit / word_bits;
+                known[word] |= known_word << shift;
+                value[word] |= value_word << shift;
+                if (shift != 0 && word + 1 < stride)
+                {
+                    known[word + 1] |= known_word >> (word_bits - shift);
+                    value[word + 1] |= value_word >> (word_bits - shift);
+                }
+            }
+            size += count;
+        }
 
     public:
+        /**
+         * @brief Выравнивание плоскостей в байтах (одна кэш-линия, один регистр AVX-512)
+         *
+         */
+        static constexpr size_t plane_alignment = 64;
+
+        /**
+         * @brief Количество слов, занимаемых size сигналами в одной плоскости
+         *
+         */
+        static size_t word_count(size_t size)
+        {
+            return (size + word_bits - 1) / word_bits;
+        }
+
+        /**
+         * @brief Ссылка на сигнал внутри вектора
+         *
+         * Возвращается оператором [], так как упакованный сигнал не имеет собственного адреса
+         */
+        class reference
+        {
+            Triple_vector *vector;
+            size_t index;
+
+            friend class Triple_vector;
+
+            reference(Triple_vector *vector, size_t index) : vector(vector), index(index) {}
+
+        public:
+            reference(const reference &other) = default;
+
+            /**
+             * @brief Присваивание сигнала элементу вектора
+             *
+             * @param signal Новое значение
+             * @return reference&
+             */
+            reference &operator=(const Triple_signal &signal);
+
+            /**
+             * @brief Присваивание значения другого элемента
+             *
+             * @param other Ссылка на элемент
+             * @return reference&
+             */
+            reference &operator=(const reference &other);
+
+            /**
+             * @brief Преобразование к сигналу
+             *
+             * @return Triple_signal Значение элемента
+             */
+            operator Triple_signal() const;
+
+            /**
+             * @brief Геттер значения сигнала
+             *
+             * @return Signal
+             */
+            Signal get_signal() const;
+
+            /**
+             * @brief Геттер значения сигнала в виде символа
+             *
+             * @return char (0/1/X)
+             */
+            char get_signal_char() const;
+
+            /**
+             * @brief Сравнение элемента с сигналом
+             *
+             * @param signal
+             * @return bool
+             */
+            bool operator==(const Triple_signal &signal) const;
+
+            /**
+             * @brief Оператор потока вывода
+             *
+             * Выводится 0/1/X
+             */
+            friend std::ostream &operator<<(std::ostream &out, const reference &signal);
+        };
+
         /**
          * @brief Конструктор по умолчанию
          *
@@ -37,6 +308,15 @@ namespace Triple_signal
          */
         Triple_vector() = default;
 
+        /**
+         * @brief Конструктор пустого вектора с ресурсом памяти
+         *
+         * Буферы вектора и всех его операций выделяются из resource
+         *
+         * @param resource Ресурс памяти, должен жить дольше вектора
+         */
+        explicit Triple_vector(std::pmr::memory_resource *resource) : resource(resource) {}
+
         /**
          * @brief Инициализирующий конструктор
          *
@@ -57,16 +337,27 @@ namespace Triple_signal
          *
          * @throw std::invalid_argument в строке есть символы кроме 0/1/x/X
          */
-        Triple_vector(std::string signals);
+        Triple_vector(std::string_view signals);
 
         /**
          * @brief Копирующий конструктор
          *
-         * Создает вектор скопировав другой
+         * Создает вектор скопировав другой. Буфер в куче не копируется,
+         * а разделяется до первого изменения одного из векторов
+         *
+         * @param vector Вектор сигналов
+         */
+        Triple_vector(const Triple_vector &vector);
+
+        /**
+         * @brief Копирующий конструктор с ресурсом памяти
+         *
+         * Буфер разделяется, только если он выделен из resource, иначе копируется в resource
          *
          * @param vector Вектор сигналов
+         * @param resource Ресурс памяти копии
          */
-        Triple_vector(const Triple_vector &vector) noexcept;
+        Triple_vector(const Triple_vector &vector, std::pmr::memory_resource *resource);
 
         /**
          * @brief Перемещающий конструктор
@@ -75,13 +366,38 @@ namespace Triple_signal
          */
         Triple_vector(Triple_vector &&vector) noexcept;
 
+        /**
+         * @brief Конструктор из выражения
+         *
+         * Вычисляет выражение за один проход без промежуточных векторов
+         *
+         * @param expr Выражение из операторов &, |, ~, +
+         */
+        template <typename E>
+        Triple_vector(const Triple_expr<E> &expr)
+        {
+            *this = expr;
+        }
+
+        /**
+         * @brief Конструктор из выражения с ресурсом памяти
+         *
+         * @param expr Выражение из операторов &, |, ~, +
+         * @param resource Ресурс памяти результата
+         */
+        template <typename E>
+        Triple_vector(const Triple_expr<E> &expr, std::pmr::memory_resource *resource) : resource(resource)
+        {
+            *this = expr;
+        }
+
         /**
          * @brief Деструктор
          *
          */
         ~Triple_vector()
         {
-            delete[] array;
+            release();
         }
 
         /**
@@ -91,7 +407,7 @@ namespace Triple_signal
          *
          * @throw std::invalid_argument в строке есть что-то кроме 0/1/x/X
          */
-        void set_signals(std::string signals);
+        void set_signals(std::string_view signals);
 
         /**
          * @brief Геттер
@@ -103,11 +419,20 @@ namespace Triple_signal
         /**
          * @brief Геттер
          *
+         * Распаковывает сигналы в новый массив, вызывающий освобождает его через delete[]
+         *
          * @param size размер полученного массива
          * @return Triple_signal* Массив сигналов
          */
         Triple_signal *get_signals(int &size) const;
 
+        /**
+         * @brief Количество сигналов в векторе
+         *
+         * @return size_t
+         */
+        size_t get_size() const;
+
         /**
          * @brief
          * Проверка на определенность вектора
@@ -121,6 +446,7 @@ namespace Triple_signal
          *
          * @param in Поток ввода
          * @throw std::invalid_argument при вводе что-то кроме 0/1/x/X
+         * @see operator>>
          */
         void input(std::istream &in);
 
@@ -134,91 +460,267 @@ namespace Triple_signal
         /**
          * @brief Перегрузка копирующего оператора
          *
+         * Вектор сохраняет свой ресурс памяти. Если буфер источника выделен из другого ресурса,
+         * сигналы копируются в собственный единоличный буфер, когда его емкости хватает
+         *
          * @param vector
          * @return Triple_vector&
          */
-        Triple_vector &operator=(const Triple_vector &vector) noexcept;
+        Triple_vector &operator=(const Triple_vector &vector);
 
         /**
          * @brief Перегрузка перемещающего оператора
          *
+         * Вектор сохраняет свой ресурс памяти. Буфер передается без копирования, только если
+         * ресурсы источника и вектора равны, иначе сигналы копируются, как копирующим оператором
+         *
          * @param vector
          * @return Triple_vector&
          */
-        Triple_vector &operator=(Triple_vector &&vector) noexcept;
+        Triple_vector &operator=(Triple_vector &&vector);
 
         /**
-         * @brief Перегрузка оператора сравнения на равенство
+         * @brief Присваивание результата выражения
          *
-         * @param vector_2
-         * @return bool
+         * Если собственный буфер в куче единоличный, вмещает результат и выражение не читает
+         * его со сдвигом (см. reads_shifted), результат вычисляется прямо в него без выделения памяти,
+         * как при свертке многовходового вентиля v = v & w. Иначе результат вычисляется в новый буфер,
+         * поэтому вектор может входить в свое же выражение
+         *
+         * @param expr Выражение из операторов &, |, ~, +
+         * @return Triple_vector&
          */
-        bool operator==(const Triple_vector &vector_2) const;
+        template <typename E>
+        Triple_vector &operator=(const Triple_expr<E> &expr)
+        {
+            size_t result_size = expr.get_size();
+            if (can_overwrite(result_size) && !reads_shifted(expr.self(), known, known + 2 * get_stride()))
+            {
+                detach();
+                size_t words = word_count(result_size);
+                evaluate_planes(expr.self(), known, value, words);
+                if (words < word_count(size))
+                {
+                    std::fill(known + words, known + word_count(size), 0);
+                    std::fill(value + words, value + word_count(size), 0);
+                }
+                size = result_size;
+                clear_tail();
+                return *this;
+            }
+
+            Triple_vector result(resource);
+            result.size = expr.get_size();
+            result.allocate(result.size);
+            evaluate_planes(expr.self(), result.known, result.value, word_count(result.size));
+            result.clear_tail();
+            return *this = std::move(result);
+        }
 
         /**
-         * @brief Перегрузка оператора сравнения на неравенство
+         * @brief Дописывает результат выражения в конец вектора
          *
-         * @param vector_2
-         * @return bool
+         * При нехватке емкости буфер растет геометрически (вдвое), поэтому серия дописываний
+         * стоит амортизированно O(1) на сигнал. Выражение может ссылаться на сам вектор
+         * и его представления: при росте оно читается из старого буфера.
+         *
+         * @param expr Выражение из операторов &, |, ~, + или вектор
+         * @return Triple_vector&
          */
-        bool operator!=(const Triple_vector &vector_2) const;
+        template <typename E>
+        Triple_vector &append(const Triple_expr<E> &expr)
+        {
+            size_t count = expr.get_size();
+            if (count == 0)
+                return *this;
+
+            if (size + count > get_capacity())
+            {
+                Triple_vector grown(resource);
+                grown.copy_from(*this, std::max(size + count, 2 * get_capacity()));
+                grown.append_unchecked(expr.self(), count);
+                return *this = std::move(grown);
+            }
+
+            detach();
+            append_unchecked(expr.self(), count);
+            return *this;
+        }
+
         /**
-         * @brief Оператор поразрядного логического ИЛИ
+         * @brief Дописывает сигнал в конец вектора за амортизированное O(1)
          *
-         * @param vector_2
-         * @return Triple_vector
+         * @param signal Сигнал
          */
-        Triple_vector operator|(const Triple_vector &vector_2) const;
+        void push_back(const Triple_signal &signal);
 
         /**
-         * @brief Оператор поразрядного логического И
+         * @brief Дописывание выражения в конец вектора
          *
-         * @param vector_2
-         * @return Triple_vector
+         * @param expr Выражение из операторов &, |, ~, + или вектор
+         * @return Triple_vector&
+         */
+        template <typename E>
+        Triple_vector &operator+=(const Triple_expr<E> &expr)
+        {
+            return append(expr);
+        }
+
+        /**
+         * @brief Дописывание сигнала в конец вектора
+         *
+         * @param signal Сигнал
+         * @return Triple_vector&
+         */
+        Triple_vector &operator+=(const Triple_signal &signal);
+
+        /**
+         * @brief Резервирует память под capacity сигналов
+         *
+         * @param capacity Требуемая емкость
          */
-        Triple_vector operator&(const Triple_vector &vector_2) const;
+        void reserve(size_t capacity);
 
         /**
-         * @brief Оператор поразрядного логического НЕ
+         * @brief Количество сигналов, которое вектор вмещает без перевыделения памяти
          *
-         * @return Triple_vector
+         * @return size_t
          */
-        Triple_vector operator~() const;
+        size_t get_capacity() const;
 
         /**
-         * @brief Сложение векторов
+         * @brief Уменьшает емкость до размера вектора
+         *
+         * Короткий вектор возвращается во встроенный буфер
+         */
+        void shrink_to_fit();
+
+        /**
+         * @brief 64 сигнала, начиная с сигнала bit, в виде слов плоскостей (интерфейс Triple_expr)
+         *
+         * @param bit Номер первого сигнала
+         * @param known_word Слово плоскости known
+         * @param value_word Слово плоскости value
+         */
+        void load(size_t bit, uint64_t &known_word, uint64_t &value_word) const
+        {
+            size_t word = bit / word_bits;
+            size_t shift = bit % word_bits;
+            size_t words = word_count(size);
+
+            if (word >= words)
+            {
+                known_word = value_word = 0;
+                return;
+            }
+
+            known_word = known[word] >> shift;
+            value_word = value[word] >> shift;
+            if (shift != 0 && word + 1 < words)
+            {
+                known_word |= known[word + 1] << (word_bits - shift);
+                value_word |= value[word + 1] << (word_bits - shift);
+            }
+        }
+
+        /**
+         * @brief Плоскость known (только для чтения)
+         *
+         * @return const uint64_t*
+         */
+        const uint64_t *get_known() const
+        {
+            return known;
+        }
+
+        /**
+         * @brief Плоскость value (только для чтения)
+         *
+         * @return const uint64_t*
+         */
+        const uint64_t *get_value() const
+        {
+            return value;
+        }
+
+        /**
+         * @brief Хэш содержимого вектора
+         *
+         * Для буфера в куче вычисляется один раз и кэшируется до изменения вектора
+         *
+         * @return uint64_t
+         */
+        uint64_t get_hash() const;
+
+        /**
+         * @brief Число векторов, разделяющих буфер этого вектора
+         *
+         * @return size_t 1 для единоличного, встроенного или пустого буфера
+         */
+        size_t get_use_count() const;
+
+        /**
+         * @brief Ресурс памяти, из которого выделяются буферы вектора
+         *
+         * @return std::pmr::memory_resource*
+         */
+        std::pmr::memory_resource *get_resource() const;
+
+        /**
+         * @brief Перегрузка оператора сравнения на равенство
+         *
+         * Векторы с общим буфером равны сразу, векторы с различными кэшированными
+         * хэшами - не равны сразу, иначе плоскости сравниваются memcmp
          *
          * @param vector_2
-         * @return Triple_vector
+         * @return bool
          */
-        Triple_vector operator+(const Triple_vector &vector_2) const;
+        bool operator==(const Triple_vector &vector_2) const;
 
         /**
-         * @brief Сложение сигнала с вектором
+         * @brief Перегрузка оператора сравнения на неравенство
          *
-         * @param signal
-         * @return Triple_vector
+         * @param vector_2
+         * @return bool
          */
-        Triple_vector operator+(const Triple_signal &signal) const;
+        bool operator!=(const Triple_vector &vector_2) const;
+
         /**
          * @brief Оператор потока ввода
          *
-         * Принимает 0/1/x/X
+         * Принимает 0/1/x/X. Слово читается прямо из буфера потока блоками
+         * без промежуточной строки, буфер вектора переиспользуется, если хватает емкости,
+         * поэтому повторное чтение векторов одной ширины не выделяет память
          *
          * @param in Поток ввода
          * @param vector Вводимый вектор
          *
          * @return std::istream& Ссылка на входной поток
          *
-         * @throw std::invalid_argument Если ввести что-то кроме 0/1/x/X
+         * @throw std::invalid_argument Если ввести что-то кроме 0/1/x/X (слово дочитывается, вектор становится пустым)
          */
         friend std::istream &operator>>(std::istream &in, Triple_vector &vector);
 
+        /**
+         * @brief Разбор вектора из начала строки
+         *
+         * Читает наибольший префикс из символов 0/1/x/X, буфер вектора переиспользуется,
+         * если хватает емкости
+         *
+         * @param first Начало строки
+         * @param last Конец строки
+         * @param vector Вектор, изменяется только при успешном разборе
+         * @return std::from_chars_result ptr - за последним сигналом;
+         * ec == std::errc::invalid_argument и ptr == first, если строка не начинается с сигнала
+         */
+        friend std::from_chars_result from_chars(const char *first, const char *last, Triple_vector &vector);
+
         /**
          * @brief Оператор потока вывода
          *
-         * Выводится 0/1/X
+         * Выводится 0/1/X без промежуточной строки
          *
+         * @see write_signals
          * @param out Поток вывода
          * @param vector Выводимый вектор
          *
@@ -227,23 +729,41 @@ namespace Triple_signal
         friend std::ostream &operator<<(std::ostream &out, const Triple_vector &vector);
 
         /**
-         * @brief
+         * @brief Доступ к элементу вектора
+         *
+         * @param index
+         * @return reference Ссылка на упакованный сигнал
+         * @throw std::out_of_range индекс больше размера вектора
+         */
+        reference operator[](size_t index);
+
+        /**
+         * @brief Чтение элемента вектора
          *
          * @param index
-         * @return Triple_signal&
+         * @return Triple_signal
          * @throw std::out_of_range индекс больше размера вектора
          */
-        Triple_signal &operator[](size_t index);
+        Triple_signal operator[](size_t index) const;
 
         /**
          * @brief Оператор среза
          *
-         * @param indices левый и правый индексы подвектора
-         * @return Triple_vector Подвектор
+         * Не копирует сигналы: возвращает представление, действительное, пока вектор жив и не изменяется
+         *
+         * @param indices левый и правый индексы подвектора (включительно)
+         * @return Triple_vector_view Представление подвектора
          * @throw std::out_of_range индекс больше размера вектора
          * @throw std::invalid_argument левый индекс больше правого
          */
-        Triple_vector operator[](const std::pair<size_t, size_t> &indices) const;
+        Triple_vector_view operator[](const std::pair<size_t, size_t> &indices) const;
+
+        /**
+         * @brief Представление всего вектора
+         *
+         * @return Triple_vector_view
+         */
+        Triple_vector_view view() const;
 
         /**
          * @brief Префиксный оператор проверки на определенность вектора
@@ -254,6 +774,126 @@ namespace Triple_signal
         bool operator!() const;
     };
 
+    std::from_chars_result from_chars(const char *first, const char *last, Triple_vector &vector);
+
+    template <>
+    struct Triple_expr_operand<Triple_vector>
+    {
+        using type = const Triple_vector &;
+    };
+
+    /**
+     * @brief Указывает ли буфер вектора в память [first, last)
+     *
+     */
+    inline bool reads_memory(const Triple_vector &vector, const uint64_t *first, const uint64_t *last)
+    {
+        std::less<const uint64_t *> less;
+        const uint64_t *known = vector.get_known();
+        return known != nullptr && !less(known, first) && less(known, last);
+    }
+
+    /**
+     * @brief Вектор читается словами с тем же номером, что и результат
+     *
+     * Чужой единоличный буфер не может совпадать с памятью результата, а свой читается без сдвига
+     */
+    inline bool reads_shifted(const Triple_vector &, const uint64_t *, const uint64_t *)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Вычисление И двух векторов ядром triple_kernels
+     *
+     */
+    void evaluate_planes(const Triple_and<Triple_vector, Triple_vector> &expr, uint64_t *known, uint64_t *value, size_t words);
+
+    /**
+     * @brief Вычисление ИЛИ двух векторов ядром triple_kernels
+     *
+     */
+    void evaluate_planes(const Triple_or<Triple_vector, Triple_vector> &expr, uint64_t *known, uint64_t *value, size_t words);
+
+    /**
+     * @brief Вычисление НЕ вектора ядром triple_kernels
+     *
+     */
+    void evaluate_planes(const Triple_not<Triple_vector> &expr, uint64_t *known, uint64_t *value, size_t words);
+
+    /**
+     * @brief Сравнение выражения с вектором без материализации выражения
+     *
+     * Без этой перегрузки в C++20 обобщенный operator== выражений и обращенный
+     * Triple_vector::operator== (с неявным построением вектора из выражения) неоднозначны
+     *
+     * @return true Размеры и все сигналы совпадают
+     * @return false Иначе
+     */
+    template <typename E>
+    bool operator==(const Triple_expr<E> &left, const Triple_vector &right)
+    {
+        return left == static_cast<const Triple_expr<Triple_vector> &>(right);
+    }
+
+    /**
+     * @brief Сравнение вектора с выражением без материализации выражения
+     *
+     */
+    template <typename E>
+    bool operator==(const Triple_vector &left, const Triple_expr<E> &right)
+    {
+        return static_cast<const Triple_expr<Triple_vector> &>(left) == right;
+    }
+
+    /**
+     * @brief Сравнение выражения с вектором на неравенство
+     *
+     */
+    template <typename E>
+    bool operator!=(const Triple_expr<E> &left, const Triple_vector &right)
+    {
+        return !(left == right);
+    }
+
+    /**
+     * @brief Сравнение вектора с выражением на неравенство
+     *
+     */
+    template <typename E>
+    bool operator!=(const Triple_vector &left, const Triple_expr<E> &right)
+    {
+        return !(left == right);
+    }
+
+    /**
+     * @brief Оператор потока вывода для выражения
+     *
+     * Выводится 0/1/X, выражение вычисляется по словам без промежуточного вектора
+     *
+     * @param out Поток вывода
+     * @param expr Выражение
+     * @return std::ostream& Ссылка на выходной поток
+     */
+    template <typename E>
+    std::ostream &operator<<(std::ostream &out, const Triple_expr<E> &expr)
+    {
+        return write_signals(out, expr);
+    }
+
 }
 
+/**
+ * @brief Хэш вектора для неупорядоченных контейнеров
+ *
+ */
+template <>
+struct std::hash<Triple_signal::Triple_vector>
+{
+    size_t operator()(const Triple_signal::Triple_vector &vector) const noexcept
+    {
+        return static_cast<size_t>(vector.get_hash());
+    }
+};
+
 #endif
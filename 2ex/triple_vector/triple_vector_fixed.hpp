@@ -0,0 +1,314 @@
+/**
+ * @file triple_vector_fixed.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий вектор троичных сигналов фиксированной ширины
+ * @version 0.1
+ * @date 2025-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_VECTOR_FIXED_H
+#define TRIPLE_VECTOR_FIXED_H
+
+#include <iostream>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "triple_vector.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Вектор из N троичных сигналов с шириной, известной при компиляции
+     *
+     * Плоскости known/value хранятся в std::array внутри объекта (без кучи),
+     * операции &, |, ~ вычисляются сразу и развернуты по словам, поэтому шины
+     * 8/16/32/64 бит компилируются в несколько инструкций над регистрами.
+     * Все операции constexpr: вектор можно построить и вычислить при компиляции.
+     *
+     * Является листом ленивых выражений Triple_expr, поэтому смешивается с Triple_vector:
+     * Triple_vector(fixed), fixed & vector, vector + fixed и т.д.
+     *
+     * @tparam N Количество сигналов
+     */
+    template <size_t N>
+    class Triple_vector_fixed : public Triple_expr<Triple_vector_fixed<N>>
+    {
+    public:
+        /**
+         * @brief Число слов в одной плоскости
+         *
+         */
+        static constexpr size_t words = (N + 63) / 64;
+
+    private:
+        std::array<uint64_t, words> known{};
+        std::array<uint64_t, words> value{};
+
+        template <typename F, size_t... I>
+        static constexpr void for_words(F &&function, std::index_sequence<I...>)
+        {
+            (function(I), ...);
+        }
+
+        /**
+         * @brief Вызывает function(i) для каждого слова, развернуто при компиляции
+         *
+         */
+        template <typename F>
+        static constexpr void for_words(F &&function)
+        {
+            for_words(function, std::make_index_sequence<words>());
+        }
+
+        static constexpr uint64_t tail_mask()
+        {
+            return N % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (N % 64)) - 1;
+        }
+
+    public:
+        /**
+         * @brief Конструктор по умолчанию
+         *
+         * Создает вектор из N неопределенных сигналов
+         *
+         */
+        constexpr Triple_vector_fixed() = default;
+
+        /**
+         * @brief Инициализирующий конструктор из строкового литерала ровно из N сигналов
+         *
+         * Длина литерала проверяется при компиляции
+         *
+         * @param signals Строка состоящая из 0/1/x/X
+         * @throw std::invalid_argument в строке есть символы кроме 0/1/x/X
+         */
+        constexpr Triple_vector_fixed(const char (&signals)[N + 1])
+            : Triple_vector_fixed(std::string_view(signals, N)) {}
+
+        /**
+         * @brief Инициализирующий конструктор из строки
+         *
+         * @param signals Строка состоящая из 0/1/x/X
+         * @throw std::invalid_argument длина строки не равна N или в ней есть символы кроме 0/1/x/X
+         */
+        constexpr explicit Triple_vector_fixed(std::string_view signals)
+        {
+            if (signals.size() != N)
+                throw std::invalid_argument("signal string length does not match vector width");
+
+            for (size_t i = 0; i < N; i++)
+            {
+                char signal = signals[i];
+                if (signal != '0' && signal != '1' && signal != 'x' && signal != 'X')
+                    throw std::invalid_argument("invalid signal");
+                set_signal(i, signal == '0' ? ZERO : signal == '1' ? ONE
+                                                                    : UNKNOWN);
+            }
+        }
+
+        /**
+         * @brief Конструктор из динамического вектора
+         *
+         * @param vector Вектор ровно из N сигналов
+         * @throw std::invalid_argument размер вектора не равен N
+         */
+        explicit Triple_vector_fixed(const Triple_vector &vector)
+        {
+            if (vector.get_size() != N)
+                throw std::invalid_argument("vector size does not match fixed width");
+
+            for_words([&](size_t i)
+                      { vector.load(i * 64, known[i], value[i]); });
+            if constexpr (words != 0)
+            {
+                known[words - 1] &= tail_mask();
+                value[words - 1] &= tail_mask();
+            }
+        }
+
+        /**
+         * @brief Количество сигналов
+         *
+         * @return size_t
+         */
+        constexpr size_t get_size() const
+        {
+            return N;
+        }
+
+        /**
+         * @brief 64 сигнала, начиная с сигнала bit, в виде слов плоскостей (интерфейс Triple_expr)
+         *
+         */
+        constexpr void load(size_t bit, uint64_t &known_word, uint64_t &value_word) const
+        {
+            size_t word = bit / 64;
+            size_t shift = bit % 64;
+            if (word >= words)
+            {
+                known_word = value_word = 0;
+                return;
+            }
+
+            known_word = known[word] >> shift;
+            value_word = value[word] >> shift;
+            if (shift != 0 && word + 1 < words)
+            {
+                known_word |= known[word + 1] << (64 - shift);
+                value_word |= value[word + 1] << (64 - shift);
+            }
+        }
+
+        /**
+         * @brief Значение сигнала без проверки индекса
+         *
+         * @param index
+         * @return Signal
+         */
+        constexpr Signal get_signal(size_t index) const
+        {
+            uint64_t bit = uint64_t(1) << (index % 64);
+            if (!(known[index / 64] & bit))
+                return UNKNOWN;
+            return (value[index / 64] & bit) ? ONE : ZERO;
+        }
+
+        /**
+         * @brief Устанавливает значение сигнала без проверки индекса
+         *
+         * @param index
+         * @param signal
+         */
+        constexpr void set_signal(size_t index, Signal signal)
+        {
+            uint64_t bit = uint64_t(1) << (index % 64);
+            known[index / 64] = signal == UNKNOWN ? known[index / 64] & ~bit : known[index / 64] | bit;
+            value[index / 64] = signal == ONE ? value[index / 64] | bit : value[index / 64] & ~bit;
+        }
+
+        /**
+         * @brief Чтение сигнала
+         *
+         * @param index
+         * @return Triple_signal
+         * @throw std::out_of_range индекс больше размера вектора
+         */
+        Triple_signal operator[](size_t index) const
+        {
+            if (index >= N)
+            {
+                throw std::out_of_range("Index " + std::to_string(index) +
+                                        " out of range for vector of size " + std::to_string(N));
+            }
+            return Triple_signal(get_signal(index));
+        }
+
+        /**
+         * @brief Геттер
+         *
+         * @return std::string Строка сигналов состоящая из 0/1/X
+         */
+        std::string get_signals() const
+        {
+            std::string result(N, 'X');
+            for (size_t i = 0; i < N; i += 64)
+                kernels::format_signals(&known[i / 64], &value[i / 64], std::min<size_t>(N - i, 64), result.data() + i);
+            return result;
+        }
+
+        /**
+         * @brief Проверка на определенность всех сигналов
+         *
+         * @return true Все сигналы определенны
+         * @return false Есть хотя бы один неопределенный сигнал
+         */
+        constexpr bool is_known() const
+        {
+            bool result = true;
+            for_words([&](size_t i)
+                      { result &= known[i] == (i + 1 == words ? tail_mask() : ~uint64_t(0)); });
+            return result;
+        }
+
+        /**
+         * @brief Поразрядное логическое И
+         *
+         */
+        friend constexpr Triple_vector_fixed operator&(const Triple_vector_fixed &left, const Triple_vector_fixed &right)
+        {
+            Triple_vector_fixed result;
+            for_words([&](size_t i)
+                      { kernels::and_word(left.known[i], left.value[i], right.known[i], right.value[i],
+                                          result.known[i], result.value[i]); });
+            return result;
+        }
+
+        /**
+         * @brief Поразрядное логическое ИЛИ
+         *
+         */
+        friend constexpr Triple_vector_fixed operator|(const Triple_vector_fixed &left, const Triple_vector_fixed &right)
+        {
+            Triple_vector_fixed result;
+            for_words([&](size_t i)
+                      { kernels::or_word(left.known[i], left.value[i], right.known[i], right.value[i],
+                                         result.known[i], result.value[i]); });
+            return result;
+        }
+
+        /**
+         * @brief Поразрядное логическое НЕ
+         *
+         */
+        friend constexpr Triple_vector_fixed operator~(const Triple_vector_fixed &operand)
+        {
+            Triple_vector_fixed result;
+            for_words([&](size_t i)
+                      { kernels::not_word(operand.known[i], operand.value[i], result.known[i], result.value[i]); });
+            return result;
+        }
+
+        /**
+         * @brief Сравнение на равенство
+         *
+         */
+        friend constexpr bool operator==(const Triple_vector_fixed &left, const Triple_vector_fixed &right)
+        {
+            return left.known == right.known && left.value == right.value;
+        }
+
+        /**
+         * @brief Сравнение на неравенство
+         *
+         */
+        friend constexpr bool operator!=(const Triple_vector_fixed &left, const Triple_vector_fixed &right)
+        {
+            return !(left == right);
+        }
+
+        /**
+         * @brief Оператор потока вывода
+         *
+         * Выводится 0/1/X
+         */
+        friend std::ostream &operator<<(std::ostream &out, const Triple_vector_fixed &vector)
+        {
+            return write_signals(out, vector);
+        }
+    };
+
+    /**
+     * @brief Вывод ширины из строкового литерала: Triple_vector_fixed bus("01X1")
+     *
+     */
+    template <size_t M>
+    Triple_vector_fixed(const char (&)[M]) -> Triple_vector_fixed<M - 1>;
+}
+
+#endif
@@ -0,0 +1,83 @@
+#include <stdexcept>
+
+#include "triple_vector_view.hpp"
+#include "triple_kernels.hpp"
+#include "triple_format.hpp"
+
+namespace Triple_signal
+{
+    std::string Triple_vector_view::get_signals() const
+    {
+        std::string result(size, 'X');
+        for (size_t bit = 0; bit < size; bit += 64)
+        {
+            uint64_t known_word, value_word;
+            load(bit, known_word, value_word);
+            kernels::format_signals(&known_word, &value_word, std::min<size_t>(size - bit, 64), result.data() + bit);
+        }
+        return result;
+    }
+
+    bool Triple_vector_view::is_known() const
+    {
+        for (size_t bit = 0; bit < size; bit += 64)
+        {
+            uint64_t known_word, value_word;
+            load(bit, known_word, value_word);
+
+            uint64_t mask = size - bit >= 64 ? ~uint64_t(0) : (uint64_t(1) << (size - bit)) - 1;
+            if ((known_word & mask) != mask)
+                return false;
+        }
+        return true;
+    }
+
+    Triple_signal Triple_vector_view::operator[](size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Index " + std::to_string(index) +
+                                    " out of range for vector of size " +
+                                    std::to_string(size));
+        }
+
+        size_t bit = offset + index;
+        uint64_t mask = uint64_t(1) << (bit % 64);
+        if (!(known[bit / 64] & mask))
+            return Triple_signal(UNKNOWN);
+        return Triple_signal((value[bit / 64] & mask) ? ONE : ZERO);
+    }
+
+    Triple_vector_view Triple_vector_view::operator[](const std::pair<size_t, size_t> &indices) const
+    {
+        size_t start = indices.first;
+        size_t end = indices.second;
+
+        if (start >= size || end >= size)
+        {
+            throw std::out_of_range("Indices out of range: [" +
+                                    std::to_string(start) + ", " +
+                                    std::to_string(end) + "] for size " +
+                                    std::to_string(size));
+        }
+
+        if (start > end)
+        {
+            throw std::invalid_argument("Start index " + std::to_string(start) +
+                                        " cannot be greater than end index " +
+                                        std::to_string(end));
+        }
+
+        return Triple_vector_view(known, value, offset + start, end - start + 1);
+    }
+
+    bool Triple_vector_view::operator!() const
+    {
+        return is_known();
+    }
+
+    std::ostream &operator<<(std::ostream &out, const Triple_vector_view &view)
+    {
+        return write_signals(out, view);
+    }
+}
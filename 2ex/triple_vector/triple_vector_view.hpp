@@ -0,0 +1,176 @@
+/**
+ * @file triple_vector_view.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий невладеющее представление части вектора троичных сигналов
+ * @version 0.1
+ * @date 2025-10-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef TRIPLE_VECTOR_VIEW_H
+#define TRIPLE_VECTOR_VIEW_H
+
+#include <iostream>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "../triple_signal/triple_signal.hpp"
+#include "triple_expr.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Невладеющее представление последовательности сигналов в упакованных плоскостях
+     *
+     * Хранит только указатели на плоскости known/value, смещение первого сигнала в битах и длину,
+     * поэтому создание и копирование представления выполняются за O(1).
+     * Представление действительно, пока жив и не изменяется вектор, на который оно указывает.
+     * Является листом ленивых выражений Triple_expr: поддерживает &, |, ~, +, == и !=.
+     */
+    class Triple_vector_view : public Triple_expr<Triple_vector_view>
+    {
+        const uint64_t *known = nullptr;
+        const uint64_t *value = nullptr;
+        size_t offset = 0;
+        size_t size = 0;
+
+    public:
+        /**
+         * @brief Конструктор по умолчанию
+         *
+         * Создает пустое представление
+         *
+         */
+        Triple_vector_view() = default;
+
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * @param known Плоскость known
+         * @param value Плоскость value
+         * @param offset Номер первого сигнала представления в плоскостях
+         * @param size Количество сигналов
+         */
+        Triple_vector_view(const uint64_t *known, const uint64_t *value, size_t offset, size_t size)
+            : known(known), value(value), offset(offset), size(size) {}
+
+        /**
+         * @brief Количество сигналов
+         *
+         * @return size_t
+         */
+        size_t get_size() const
+        {
+            return size;
+        }
+
+        /**
+         * @brief 64 сигнала, начиная с сигнала bit, в виде слов плоскостей (интерфейс Triple_expr)
+         *
+         * @param bit Номер первого сигнала относительно начала представления
+         * @param known_word Слово плоскости known
+         * @param value_word Слово плоскости value
+         */
+        void load(size_t bit, uint64_t &known_word, uint64_t &value_word) const
+        {
+            size_t first = offset + bit;
+            size_t word = first / 64;
+            size_t shift = first % 64;
+            size_t words = (offset + size + 63) / 64;
+
+            if (bit >= size)
+            {
+                known_word = value_word = 0;
+                return;
+            }
+
+            known_word = known[word] >> shift;
+            value_word = value[word] >> shift;
+            if (shift != 0 && word + 1 < words)
+            {
+                known_word |= known[word + 1] << (64 - shift);
+                value_word |= value[word + 1] << (64 - shift);
+            }
+        }
+
+        /**
+         * @brief Геттер
+         *
+         * @return std::string Строка сигналов состоящая из 0/1/X
+         */
+        std::string get_signals() const;
+
+        /**
+         * @brief Проверка на определенность всех сигналов представления
+         *
+         * @return true Все сигналы определенны
+         * @return false Есть хотя бы один неопределенный сигнал
+         */
+        bool is_known() const;
+
+        /**
+         * @brief Чтение сигнала
+         *
+         * @param index
+         * @return Triple_signal
+         * @throw std::out_of_range индекс больше размера представления
+         */
+        Triple_signal operator[](size_t index) const;
+
+        /**
+         * @brief Оператор среза
+         *
+         * @param indices левый и правый индексы (включительно)
+         * @return Triple_vector_view Представление части этого представления
+         * @throw std::out_of_range индекс больше размера представления
+         * @throw std::invalid_argument левый индекс больше правого
+         */
+        Triple_vector_view operator[](const std::pair<size_t, size_t> &indices) const;
+
+        /**
+         * @brief Префиксный оператор проверки на определенность
+         *
+         * @return true Все сигналы определенны
+         * @return false Есть хотя бы один неопределенный сигнал
+         */
+        bool operator!() const;
+
+        /**
+         * @brief Оператор потока вывода
+         *
+         * Выводится 0/1/X
+         *
+         * @param out Поток вывода
+         * @param view Выводимое представление
+         *
+         * @return std::ostream& Ссылка на выходной поток
+         */
+        friend std::ostream &operator<<(std::ostream &out, const Triple_vector_view &view);
+
+        /**
+         * @brief Указывает ли представление в память [first, last)
+         *
+         */
+        friend bool reads_memory(const Triple_vector_view &view, const uint64_t *first, const uint64_t *last)
+        {
+            std::less<const uint64_t *> less;
+            auto inside = [&](const uint64_t *plane)
+            { return plane != nullptr && !less(plane, first) && less(plane, last); };
+            return inside(view.known) || inside(view.value);
+        }
+
+        /**
+         * @brief Читает ли представление память [first, last) со сдвигом
+         *
+         * Представление с начала плоскостей first без смещения читает слово с тем же номером
+         */
+        friend bool reads_shifted(const Triple_vector_view &view, const uint64_t *first, const uint64_t *last)
+        {
+            return reads_memory(view, first, last) && (view.known != first || view.offset != 0);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,194 @@
+#include <stdexcept>
+#include <cstring>
+#include <utility>
+
+#include "mapped_vector.hpp"
+#include "waveform.hpp"
+
+#if WAVEFORM_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Triple_signal
+{
+    Triple_mapped_vector::Triple_mapped_vector(const std::string &path, Map_mode mode, size_t record) : mode(mode)
+    {
+#if WAVEFORM_HAS_MMAP
+        file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            throw std::runtime_error("cannot open " + path);
+
+        struct stat info;
+        if (::fstat(file, &info) != 0 || size_t(info.st_size) < waveform_header_size)
+        {
+            unmap();
+            throw std::runtime_error("not a waveform file: " + path);
+        }
+        length = info.st_size;
+
+        // MAP_PRIVATE с правом записи не меняет файл, поэтому достаточно открыть его только для чтения
+        void *mapped = mode == Map_mode::READ_ONLY
+                           ? ::mmap(nullptr, length, PROT_READ, MAP_SHARED, file, 0)
+                           : ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        if (mapped == MAP_FAILED)
+        {
+            length = 0;
+            unmap();
+            throw std::runtime_error("cannot map " + path);
+        }
+        data = static_cast<unsigned char *>(mapped);
+
+        uint32_t version;
+        std::memcpy(&version, data + sizeof(waveform_magic), sizeof(version));
+        if (std::memcmp(data, waveform_magic, sizeof(waveform_magic)) != 0 || version != waveform_version)
+        {
+            unmap();
+            throw std::runtime_error("not a waveform file: " + path);
+        }
+
+        // Пропуск предыдущих записей читает только их заголовки, плоскости проверяются у выбранной
+        size_t position = waveform_header_size;
+        for (size_t current = 0;; current++)
+        {
+            if (position == length)
+            {
+                unmap();
+                throw std::out_of_range("Record " + std::to_string(record) + " out of range for " + path);
+            }
+
+            size_t record_size, planes;
+            try
+            {
+                planes = find_mapped_record(data, length, position, record_size, current == record);
+            }
+            catch (...)
+            {
+                unmap();
+                throw;
+            }
+
+            if (current == record)
+            {
+                size = record_size;
+                known = reinterpret_cast<uint64_t *>(data + planes);
+                value = known + Triple_vector::word_count(record_size);
+                break;
+            }
+        }
+#else
+        throw std::runtime_error("memory mapped vectors are not supported on this platform: " + path);
+#endif
+    }
+
+    Triple_mapped_vector::Triple_mapped_vector(Triple_mapped_vector &&vector) noexcept
+        : file(std::exchange(vector.file, -1)),
+          data(std::exchange(vector.data, nullptr)),
+          length(std::exchange(vector.length, 0)),
+          mode(vector.mode),
+          size(std::exchange(vector.size, 0)),
+          known(std::exchange(vector.known, nullptr)),
+          value(std::exchange(vector.value, nullptr)) {}
+
+    Triple_mapped_vector &Triple_mapped_vector::operator=(Triple_mapped_vector &&vector) noexcept
+    {
+        if (this != &vector)
+        {
+            unmap();
+            file = std::exchange(vector.file, -1);
+            data = std::exchange(vector.data, nullptr);
+            length = std::exchange(vector.length, 0);
+            mode = vector.mode;
+            size = std::exchange(vector.size, 0);
+            known = std::exchange(vector.known, nullptr);
+            value = std::exchange(vector.value, nullptr);
+        }
+        return *this;
+    }
+
+    Triple_mapped_vector::~Triple_mapped_vector()
+    {
+        unmap();
+    }
+
+    void Triple_mapped_vector::unmap()
+    {
+#if WAVEFORM_HAS_MMAP
+        if (data != nullptr)
+            ::munmap(data, length);
+        if (file >= 0)
+            ::close(file);
+#endif
+        file = -1;
+        data = nullptr;
+        length = 0;
+        size = 0;
+        known = value = nullptr;
+    }
+
+    Map_mode Triple_mapped_vector::get_mode() const
+    {
+        return mode;
+    }
+
+    const uint64_t *Triple_mapped_vector::get_known() const
+    {
+        return known;
+    }
+
+    const uint64_t *Triple_mapped_vector::get_value() const
+    {
+        return value;
+    }
+
+    Triple_signal Triple_mapped_vector::operator[](size_t index) const
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Index " + std::to_string(index) +
+                                    " out of range for vector of size " + std::to_string(size));
+        }
+
+        uint64_t bit = uint64_t(1) << (index % 64);
+        if (!(known[index / 64] & bit))
+            return Triple_signal(UNKNOWN);
+        return Triple_signal((value[index / 64] & bit) ? ONE : ZERO);
+    }
+
+    void Triple_mapped_vector::set_signal(size_t index, const Triple_signal &signal)
+    {
+        if (index >= size)
+        {
+            throw std::out_of_range("Index " + std::to_string(index) +
+                                    " out of range for vector of size " + std::to_string(size));
+        }
+        if (mode == Map_mode::READ_ONLY)
+            throw std::logic_error("vector is mapped read-only");
+
+        uint64_t bit = uint64_t(1) << (index % 64);
+        size_t word = index / 64;
+        Signal new_value = signal.get_signal();
+
+        if (new_value == UNKNOWN)
+            known[word] &= ~bit;
+        else
+            known[word] |= bit;
+
+        if (new_value == ONE)
+            value[word] |= bit;
+        else
+            value[word] &= ~bit;
+    }
+
+    void Triple_mapped_vector::advise(bool sequential) const
+    {
+#if WAVEFORM_HAS_MMAP
+        if (data != nullptr)
+            ::madvise(data, length, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+#else
+        (void)sequential;
+#endif
+    }
+}
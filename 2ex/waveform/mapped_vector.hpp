@@ -0,0 +1,181 @@
+/**
+ * @file mapped_vector.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий вектор троичных сигналов, отображенный из файла в память
+ * @version 0.1
+ * @date 2025-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef MAPPED_VECTOR_H
+#define MAPPED_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../triple_vector/triple_vector.hpp"
+
+namespace Triple_signal
+{
+    /**
+     * @brief Режим отображения файла
+     *
+     */
+    enum class Map_mode
+    {
+        READ_ONLY,    ///< Только чтение, страницы разделяются со всеми процессами, отобразившими файл
+        COPY_ON_WRITE ///< Изменения копируют затронутые страницы в память процесса, файл не меняется
+    };
+
+    /**
+     * @brief Вектор троичных сигналов, плоскости которого лежат в отображенном двоичном файле векторов
+     *
+     * Файл имеет формат Waveform_binary_writer, вектором становится одна из его записей.
+     * Открытие не читает плоскости, поэтому вектор любого размера открывается мгновенно,
+     * а страницы подгружаются системой по мере обращения: выражения &, |, ~, +
+     * и свертки над вектором читают файл последовательно, слово за словом, не загружая его в кучу.
+     *
+     * Является листом ленивых выражений Triple_expr: Triple_vector(mapped & vector), and_reduce(mapped) и т.д.
+     * Плоскости записи проверяются при открытии, как в Waveform_binary_reader.
+     */
+    class Triple_mapped_vector : public Triple_expr<Triple_mapped_vector>
+    {
+        int file = -1;
+        unsigned char *data = nullptr;
+        size_t length = 0;
+        Map_mode mode = Map_mode::READ_ONLY;
+        size_t size = 0;
+        uint64_t *known = nullptr;
+        uint64_t *value = nullptr;
+
+        /**
+         * @brief Снимает отображение и закрывает файл
+         *
+         */
+        void unmap();
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * @param path Путь к двоичному файлу векторов
+         * @param mode Режим отображения
+         * @param record Номер записи файла (с нуля)
+         * @throw std::runtime_error файл не открывается, не отображается, имеет неверный заголовок,
+         * обрезан или запись повреждена
+         * @throw std::out_of_range в файле меньше record + 1 записей
+         */
+        explicit Triple_mapped_vector(const std::string &path, Map_mode mode = Map_mode::READ_ONLY, size_t record = 0);
+
+        Triple_mapped_vector(const Triple_mapped_vector &) = delete;
+        Triple_mapped_vector &operator=(const Triple_mapped_vector &) = delete;
+
+        /**
+         * @brief Перемещающий конструктор
+         *
+         */
+        Triple_mapped_vector(Triple_mapped_vector &&vector) noexcept;
+
+        /**
+         * @brief Перемещающий оператор присваивания
+         *
+         */
+        Triple_mapped_vector &operator=(Triple_mapped_vector &&vector) noexcept;
+
+        /**
+         * @brief Деструктор
+         *
+         * Снимает отображение и закрывает файл, изменения в режиме COPY_ON_WRITE теряются
+         */
+        ~Triple_mapped_vector();
+
+        /**
+         * @brief Количество сигналов
+         *
+         * @return size_t
+         */
+        size_t get_size() const
+        {
+            return size;
+        }
+
+        /**
+         * @brief 64 сигнала, начиная с сигнала bit, в виде слов плоскостей (интерфейс Triple_expr)
+         *
+         */
+        void load(size_t bit, uint64_t &known_word, uint64_t &value_word) const
+        {
+            view().load(bit, known_word, value_word);
+        }
+
+        /**
+         * @brief Режим отображения
+         *
+         * @return Map_mode
+         */
+        Map_mode get_mode() const;
+
+        /**
+         * @brief Отображенная плоскость known
+         *
+         * @return const uint64_t*
+         */
+        const uint64_t *get_known() const;
+
+        /**
+         * @brief Отображенная плоскость value
+         *
+         * @return const uint64_t*
+         */
+        const uint64_t *get_value() const;
+
+        /**
+         * @brief Представление всего вектора
+         *
+         * @return Triple_vector_view
+         */
+        Triple_vector_view view() const
+        {
+            return Triple_vector_view(known, value, 0, size);
+        }
+
+        /**
+         * @brief Чтение сигнала
+         *
+         * @param index
+         * @return Triple_signal
+         * @throw std::out_of_range индекс больше размера вектора
+         */
+        Triple_signal operator[](size_t index) const;
+
+        /**
+         * @brief Изменение сигнала в режиме COPY_ON_WRITE
+         *
+         * Страница с сигналом копируется в память процесса при первом изменении
+         *
+         * @param index
+         * @param signal
+         * @throw std::out_of_range индекс больше размера вектора
+         * @throw std::logic_error вектор отображен только для чтения
+         */
+        void set_signal(size_t index, const Triple_signal &signal);
+
+        /**
+         * @brief Подсказка системе о порядке обращения к страницам
+         *
+         * @param sequential true - последовательный обход (упреждающее чтение),
+         * false - произвольный доступ (без упреждающего чтения)
+         */
+        void advise(bool sequential) const;
+    };
+
+    template <>
+    struct Triple_expr_operand<Triple_mapped_vector>
+    {
+        using type = const Triple_mapped_vector &;
+    };
+}
+
+#endif
@@ -0,0 +1,382 @@
+#include <cstdint>
+#include <stdexcept>
+#include <cstring>
+
+#include "waveform.hpp"
+#include "../triple_vector/triple_kernels.hpp"
+
+#if WAVEFORM_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Triple_signal
+{
+    namespace
+    {
+        /**
+         * @brief Сколько символов строки копится перед разбором
+         *
+         */
+        constexpr size_t parse_block = 4096;
+
+        /**
+         * @brief Сколько слов плоскости пишется в поток за раз
+         *
+         */
+        constexpr size_t write_words = 512;
+
+        /**
+         * @brief Сколько слов плоскости читается из потока за раз
+         *
+         * Память под плоскость растет по мере поступления данных, поэтому размер
+         * из поврежденной записи не приводит к выделению памяти больше, чем есть в файле
+         */
+        constexpr size_t read_words = 64 * 1024;
+
+        size_t word_count(size_t size)
+        {
+            return (size + 63) / 64;
+        }
+
+        uint64_t tail_mask(size_t size)
+        {
+            return size % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (size % 64)) - 1;
+        }
+
+        /**
+         * @brief Проверка инварианта плоскостей прочитанной записи
+         *
+         * value может быть установлен только там, где установлен known, биты за концом нулевые
+         */
+        bool is_canonical(const uint64_t *known, const uint64_t *value, size_t size)
+        {
+            size_t words = word_count(size);
+            for (size_t i = 0; i < words; i++)
+            {
+                if (value[i] & ~known[i])
+                    return false;
+            }
+            return words == 0 || ((known[words - 1] & ~tail_mask(size)) == 0);
+        }
+
+        /**
+         * @brief Чтение words слов одной плоскости кусками по read_words
+         *
+         * @return false Поток закончился раньше
+         */
+        bool read_plane(std::istream &in, std::vector<uint64_t> &plane, size_t words)
+        {
+            plane.clear();
+            for (size_t done = 0; done < words;)
+            {
+                size_t count = std::min(read_words, words - done);
+                plane.resize(done + count);
+                if (!in.read(reinterpret_cast<char *>(plane.data() + done), count * sizeof(uint64_t)))
+                    return false;
+                done += count;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Запись одной плоскости представления, выровненной с нулевого бита
+         *
+         */
+        template <bool Known>
+        void write_plane(std::ostream &out, const Triple_vector_view &view)
+        {
+            uint64_t buffer[write_words];
+            size_t size = view.get_size();
+            size_t words = word_count(size);
+
+            for (size_t first = 0; first < words; first += write_words)
+            {
+                size_t count = std::min(write_words, words - first);
+                for (size_t i = 0; i < count; i++)
+                {
+                    uint64_t known_word, value_word;
+                    view.load((first + i) * 64, known_word, value_word);
+                    buffer[i] = Known ? known_word : value_word;
+                }
+                if (first + count == words)
+                    buffer[count - 1] &= tail_mask(size);
+                out.write(reinterpret_cast<const char *>(buffer), count * sizeof(uint64_t));
+            }
+        }
+    }
+
+    Waveform_text_reader::Waveform_text_reader(std::istream &in, size_t buffer_size)
+        : in(in), buffer(std::max<size_t>(buffer_size, 1)) {}
+
+    bool Waveform_text_reader::refill()
+    {
+        in.read(buffer.data(), buffer.size());
+        filled = in.gcount();
+        position = 0;
+        return filled != 0;
+    }
+
+    void Waveform_text_reader::flush(bool line_end)
+    {
+        // Последний символ до конца строки не разбирается: он может оказаться '\r'
+        size_t count = line_end ? pending.size() : (pending.size() - 1) / 64 * 64;
+        if (count == 0)
+            return;
+
+        size_t first_word = parsed / 64;
+        known_words.resize(first_word + word_count(count));
+        value_words.resize(first_word + word_count(count));
+        std::fill(known_words.begin() + first_word, known_words.end(), 0);
+        std::fill(value_words.begin() + first_word, value_words.end(), 0);
+
+        size_t checked = kernels::parse_signals(pending.data(), count,
+                                                known_words.data() + first_word,
+                                                value_words.data() + first_word);
+        if (checked != count)
+        {
+            throw std::invalid_argument("invalid signal at line " + std::to_string(line) +
+                                        ", position " + std::to_string(parsed + checked));
+        }
+
+        parsed += count;
+        pending.erase(0, count);
+    }
+
+    bool Waveform_text_reader::next(Triple_vector &vector)
+    {
+        pending.clear();
+        known_words.clear();
+        value_words.clear();
+        parsed = 0;
+
+        bool started = false;
+        while (true)
+        {
+            if (position == filled && !refill())
+            {
+                if (!started)
+                    return false;
+                break;
+            }
+
+            if (!started)
+            {
+                line++;
+                started = true;
+            }
+
+            const char *begin = buffer.data() + position;
+            const char *end = buffer.data() + filled;
+            const char *newline = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+
+            pending.append(begin, newline ? newline : end);
+            if (pending.size() > parse_block)
+                flush(false);
+
+            if (!newline)
+            {
+                position = filled;
+                continue;
+            }
+
+            position = newline - buffer.data() + 1;
+            if (!pending.empty() && pending.back() == '\r')
+                pending.pop_back();
+
+            if (parsed == 0 && pending.empty())
+            {
+                started = false;
+                continue;
+            }
+            break;
+        }
+
+        if (!pending.empty() && pending.back() == '\r')
+            pending.pop_back();
+        flush(true);
+
+        vector = Triple_vector(Triple_vector_view(known_words.data(), value_words.data(), 0, parsed));
+        return true;
+    }
+
+    size_t Waveform_text_reader::get_line() const
+    {
+        return line;
+    }
+
+    Waveform_text_writer::Waveform_text_writer(std::ostream &out) : out(out) {}
+
+    void Waveform_text_writer::write(const Triple_vector_view &view)
+    {
+        char buffer[parse_block];
+        size_t size = view.get_size();
+
+        for (size_t first = 0; first < size; first += parse_block)
+        {
+            size_t count = std::min(parse_block, size - first);
+            for (size_t bit = 0; bit < count; bit += 64)
+            {
+                uint64_t known_word, value_word;
+                view.load(first + bit, known_word, value_word);
+                kernels::format_signals(&known_word, &value_word, std::min<size_t>(count - bit, 64), buffer + bit);
+            }
+            out.write(buffer, count);
+        }
+        out.put('\n');
+    }
+
+    void Waveform_text_writer::write(const Triple_vector &vector)
+    {
+        write(vector.view());
+    }
+
+    Waveform_binary_reader::Waveform_binary_reader(std::istream &in) : in(in)
+    {
+        char magic[sizeof(waveform_magic)];
+        uint32_t version = 0;
+        in.read(magic, sizeof(magic));
+        in.read(reinterpret_cast<char *>(&version), sizeof(version));
+
+        if (!in || std::memcmp(magic, waveform_magic, sizeof(magic)) != 0)
+            throw std::runtime_error("not a waveform file");
+        if (version != waveform_version)
+            throw std::runtime_error("unsupported waveform version " + std::to_string(version));
+    }
+
+    bool Waveform_binary_reader::next(Triple_vector &vector)
+    {
+        uint64_t size = 0;
+        in.read(reinterpret_cast<char *>(&size), sizeof(size));
+        if (in.gcount() == 0)
+            return false;
+        if (!in)
+            throw std::runtime_error("truncated waveform record");
+
+        if (size > SIZE_MAX - 63)
+            throw std::runtime_error("corrupted waveform record");
+
+        size_t words = word_count(size);
+        if (!read_plane(in, known_words, words) || !read_plane(in, value_words, words))
+            throw std::runtime_error("truncated waveform record");
+        if (!is_canonical(known_words.data(), value_words.data(), size))
+            throw std::runtime_error("corrupted waveform record");
+
+        vector = Triple_vector(Triple_vector_view(known_words.data(), value_words.data(), 0, size));
+        return true;
+    }
+
+    Waveform_binary_writer::Waveform_binary_writer(std::ostream &out) : out(out)
+    {
+        out.write(waveform_magic, sizeof(waveform_magic));
+        out.write(reinterpret_cast<const char *>(&waveform_version), sizeof(waveform_version));
+    }
+
+    void Waveform_binary_writer::write(const Triple_vector_view &view)
+    {
+        uint64_t size = view.get_size();
+        out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        write_plane<true>(out, view);
+        write_plane<false>(out, view);
+    }
+
+    void Waveform_binary_writer::write(const Triple_vector &vector)
+    {
+        write(vector.view());
+    }
+
+    size_t find_mapped_record(const unsigned char *data, size_t length, size_t &position, size_t &size, bool validate)
+    {
+        if (length - position < sizeof(uint64_t))
+            throw std::runtime_error("truncated waveform record");
+
+        uint64_t record_size;
+        std::memcpy(&record_size, data + position, sizeof(record_size));
+
+        size_t available = (length - position - sizeof(uint64_t)) / sizeof(uint64_t);
+        if (record_size / 64 > available || 2 * word_count(record_size) > available)
+            throw std::runtime_error("truncated waveform record");
+        size_t words = word_count(record_size);
+
+        // Заголовок и записи кратны 8 байтам, поэтому слова плоскостей выровнены
+        size_t planes = position + sizeof(uint64_t);
+        if (validate)
+        {
+            const uint64_t *known = reinterpret_cast<const uint64_t *>(data + planes);
+            if (!is_canonical(known, known + words, record_size))
+                throw std::runtime_error("corrupted waveform record");
+        }
+
+        size = record_size;
+        position = planes + sizeof(uint64_t) * 2 * words;
+        return planes;
+    }
+
+    Waveform_mapped_reader::Waveform_mapped_reader(const std::string &path)
+    {
+#if WAVEFORM_HAS_MMAP
+        file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            throw std::runtime_error("cannot open " + path);
+
+        struct stat info;
+        if (::fstat(file, &info) != 0 || size_t(info.st_size) < waveform_header_size)
+        {
+            ::close(file);
+            throw std::runtime_error("not a waveform file: " + path);
+        }
+        length = info.st_size;
+
+        void *mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapped == MAP_FAILED)
+        {
+            ::close(file);
+            throw std::runtime_error("cannot map " + path);
+        }
+        data = static_cast<const unsigned char *>(mapped);
+        ::madvise(mapped, length, MADV_SEQUENTIAL);
+
+        uint32_t version;
+        std::memcpy(&version, data + sizeof(waveform_magic), sizeof(version));
+        if (std::memcmp(data, waveform_magic, sizeof(waveform_magic)) != 0 || version != waveform_version)
+        {
+            ::munmap(mapped, length);
+            ::close(file);
+            throw std::runtime_error("not a waveform file: " + path);
+        }
+        position = waveform_header_size;
+#else
+        throw std::runtime_error("memory mapped waveforms are not supported on this platform: " + path);
+#endif
+    }
+
+    Waveform_mapped_reader::~Waveform_mapped_reader()
+    {
+#if WAVEFORM_HAS_MMAP
+        ::munmap(const_cast<unsigned char *>(data), length);
+        ::close(file);
+#endif
+    }
+
+    bool Waveform_mapped_reader::next(Triple_vector_view &view)
+    {
+        if (position == length)
+            return false;
+
+        // Каждая запись проверяется один раз: после rewind уже проверенные записи не читаются заново
+        size_t size;
+        size_t planes = find_mapped_record(data, length, position, size, position >= checked);
+        checked = std::max(checked, position);
+
+        const uint64_t *known = reinterpret_cast<const uint64_t *>(data + planes);
+        view = Triple_vector_view(known, known + word_count(size), 0, size);
+        return true;
+    }
+
+    void Waveform_mapped_reader::rewind()
+    {
+        position = waveform_header_size;
+    }
+}
@@ -0,0 +1,261 @@
+/**
+ * @file waveform.hpp
+ * @author Alexey Parfenov
+ * @brief Заголовочный файл, содержащий потоковое чтение и запись файлов векторов троичных сигналов
+ * @version 0.1
+ * @date 2025-10-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef WAVEFORM_H
+#define WAVEFORM_H
+
+#include <iostream>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../triple_vector/triple_vector.hpp"
+
+#if __has_include(<sys/mman.h>)
+#define WAVEFORM_HAS_MMAP 1
+#else
+#define WAVEFORM_HAS_MMAP 0
+#endif
+
+namespace Triple_signal
+{
+    /**
+     * @brief Сигнатура двоичного файла векторов
+     *
+     * Формат: "TRVW", uint32 версия, далее записи:
+     * uint64 количество сигналов, слова плоскости known, слова плоскости value.
+     * Все числа - uint64/uint32 в порядке байт машины, записи выровнены по 8 байт.
+     */
+    constexpr char waveform_magic[4] = {'T', 'R', 'V', 'W'};
+
+    /**
+     * @brief Версия двоичного формата
+     *
+     */
+    constexpr uint32_t waveform_version = 1;
+
+    /**
+     * @brief Размер заголовка двоичного файла: сигнатура и версия
+     *
+     */
+    constexpr size_t waveform_header_size = sizeof(waveform_magic) + sizeof(waveform_version);
+
+    /**
+     * @brief Поиск записи двоичного файла векторов, отображенного в память
+     *
+     * @param data Начало файла
+     * @param length Длина файла в байтах
+     * @param position Смещение записи; после вызова - смещение следующей записи
+     * @param size Количество сигналов записи
+     * @param validate Проверить плоскости записи, а не только ее границы
+     * @return size_t Смещение плоскости known, за ней сразу идет плоскость value
+     * @throw std::runtime_error запись выходит за конец файла или повреждена
+     */
+    size_t find_mapped_record(const unsigned char *data, size_t length, size_t &position, size_t &size, bool validate);
+
+    /**
+     * @brief Потоковое чтение текстового файла: один вектор 0/1/x/X на строку
+     *
+     * Строка разбирается блоками по мере чтения, поэтому кроме самого вектора
+     * читатель держит в памяти только буфер фиксированного размера.
+     * Пустые строки пропускаются, завершающий '\r' отбрасывается.
+     */
+    class Waveform_text_reader
+    {
+        std::istream &in;
+        std::vector<char> buffer;
+        size_t position = 0;
+        size_t filled = 0;
+        size_t line = 0;
+
+        std::string pending;
+        std::vector<uint64_t> known_words;
+        std::vector<uint64_t> value_words;
+        size_t parsed = 0;
+
+        bool refill();
+        void flush(bool line_end);
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * @param in Поток ввода
+         * @param buffer_size Размер буфера чтения в байтах
+         */
+        explicit Waveform_text_reader(std::istream &in, size_t buffer_size = 1 << 16);
+
+        /**
+         * @brief Читает следующий вектор
+         *
+         * @param vector Прочитанный вектор
+         * @return true Вектор прочитан
+         * @return false Поток закончился
+         * @throw std::invalid_argument в строке есть символы кроме 0/1/x/X
+         */
+        bool next(Triple_vector &vector);
+
+        /**
+         * @brief Номер последней прочитанной строки (с единицы)
+         *
+         * @return size_t
+         */
+        size_t get_line() const;
+    };
+
+    /**
+     * @brief Запись векторов в текстовый файл, по одному на строку
+     *
+     */
+    class Waveform_text_writer
+    {
+        std::ostream &out;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * @param out Поток вывода
+         */
+        explicit Waveform_text_writer(std::ostream &out);
+
+        /**
+         * @brief Записывает вектор строкой 0/1/X
+         *
+         * Сигналы форматируются блоками во внутренний буфер без промежуточной строки
+         *
+         * @param view Записываемые сигналы
+         */
+        void write(const Triple_vector_view &view);
+
+        /**
+         * @brief Записывает вектор строкой 0/1/X
+         *
+         * @param vector Записываемый вектор
+         */
+        void write(const Triple_vector &vector);
+    };
+
+    /**
+     * @brief Потоковое чтение двоичного файла векторов
+     *
+     */
+    class Waveform_binary_reader
+    {
+        std::istream &in;
+        std::vector<uint64_t> known_words;
+        std::vector<uint64_t> value_words;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор, проверяет заголовок файла
+         *
+         * @param in Поток ввода (открытый в двоичном режиме)
+         * @throw std::runtime_error неверная сигнатура или версия
+         */
+        explicit Waveform_binary_reader(std::istream &in);
+
+        /**
+         * @brief Читает следующий вектор
+         *
+         * @param vector Прочитанный вектор
+         * @return true Вектор прочитан
+         * @return false Поток закончился
+         * @throw std::runtime_error запись обрезана или повреждена
+         */
+        bool next(Triple_vector &vector);
+    };
+
+    /**
+     * @brief Запись векторов в двоичный файл
+     *
+     */
+    class Waveform_binary_writer
+    {
+        std::ostream &out;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор, записывает заголовок файла
+         *
+         * @param out Поток вывода (открытый в двоичном режиме)
+         */
+        explicit Waveform_binary_writer(std::ostream &out);
+
+        /**
+         * @brief Записывает вектор
+         *
+         * @param view Записываемые сигналы
+         */
+        void write(const Triple_vector_view &view);
+
+        /**
+         * @brief Записывает вектор
+         *
+         * @param vector Записываемый вектор
+         */
+        void write(const Triple_vector &vector);
+    };
+
+    /**
+     * @brief Чтение двоичного файла векторов через отображение в память (mmap)
+     *
+     * Векторы возвращаются представлениями прямо в отображенные страницы,
+     * поэтому открытие файла любого размера происходит мгновенно, а страницы
+     * подгружаются системой по мере обращения к ним.
+     * Представления действительны, пока жив объект Waveform_mapped_reader.
+     * Плоскости записи проверяются при первом чтении, как в Waveform_binary_reader.
+     */
+    class Waveform_mapped_reader
+    {
+        int file = -1;
+        const unsigned char *data = nullptr;
+        size_t length = 0;
+        size_t position = 0;
+        size_t checked = 0;
+
+    public:
+        /**
+         * @brief Инициализирующий конструктор
+         *
+         * @param path Путь к двоичному файлу векторов
+         * @throw std::runtime_error файл не открывается, не отображается или имеет неверный заголовок
+         */
+        explicit Waveform_mapped_reader(const std::string &path);
+
+        Waveform_mapped_reader(const Waveform_mapped_reader &) = delete;
+        Waveform_mapped_reader &operator=(const Waveform_mapped_reader &) = delete;
+
+        /**
+         * @brief Деструктор
+         *
+         * Снимает отображение и закрывает файл
+         */
+        ~Waveform_mapped_reader();
+
+        /**
+         * @brief Следующий вектор файла
+         *
+         * @param view Представление вектора в отображенной памяти
+         * @return true Вектор прочитан
+         * @return false Файл закончился
+         * @throw std::runtime_error запись выходит за конец файла или повреждена
+         */
+        bool next(Triple_vector_view &view);
+
+        /**
+         * @brief Возвращает чтение к первому вектору
+         *
+         */
+        void rewind();
+    };
+}
+
+#endif
@@ -86,7 +86,7 @@ Level::Level(int width, int height)
 
     for(int i = 0; i < height; ++i) {
         for(int j = 0; j < width; ++j) {
-            map[i][j] = Cell(CellType::EMPTY);
+            map(i, j) = Cell(CellType::EMPTY);
         }
     }
 }
@@ -102,8 +102,8 @@ void Level::build_map(const MapConfig& config) {
 
         for(int i = 0; i < config.height; ++i) {
             for(int j = 0; j < config.width; ++j) {
-                if(!map.is_valid_position(i, j) || map[i][j].get_type() == CellType::EMPTY) {
-                    map[i][j] = Cell(CellType::EMPTY);
+                if(!map.is_valid_position(i, j) || map(i, j).get_type() == CellType::EMPTY) {
+                    map(i, j) = Cell(CellType::EMPTY);
                 }
             }
         }
@@ -145,7 +145,7 @@ void Level::load_from_file(const std::string& filepath) {
                 default: cell_type = CellType::EMPTY; break;
             }
 
-            map[i][j] = Cell(cell_type);
+            map(i, j) = Cell(cell_type);
         }
     }
 
@@ -162,7 +162,7 @@ void Level::save_to_file(const std::string& filepath) const {
 
     for(int i = 0; i < map.get_rows(); ++i) {
         for(int j = 0; j < map.get_cols(); ++j) {
-            CellType type = map[i][j].get_type();
+            CellType type = map(i, j).get_type();
             char cell_char;
 
             switch(type) {
@@ -189,14 +189,14 @@ Cell& Level::get_cell(int x, int y) {
     if(!is_valid_position(x, y)) {
         throw std::out_of_range("Координаты клетки вне границ карты");
     }
-    return map[y][x];
+    return map(y, x);
 }
 
 const Cell& Level::get_cell(int x, int y) const {
     if(!is_valid_position(x, y)) {
         throw std::out_of_range("Координаты клетки вне границ карты");
     }
-    return map[y][x];
+    return map(y, x);
 }
 
 bool Level::is_valid_position(int x, int y) const {
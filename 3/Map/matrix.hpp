@@ -5,8 +5,13 @@
  * Реализует полноценный контейнер с поддержкой:
  * - Container: базовые операции (begin, end, size, empty, swap)
  * - ReversibleContainer: обратные итераторы (rbegin, rend)
- * - ContiguousContainer: непрерывное хранение в памяти, data()
+ * - Непрерывное хранение в памяти, data(): строки подряд с шагом get_stride()
+ * - Запас ёмкости по строкам и столбцам (reserve, shrink_to_fit), resize без переноса ячеек
  * - RandomAccess: произвольный доступ за O(1) через operator[i][j]
+ * - AllocatorAwareContainer: память выделяется аллокатором (std или pmr),
+ *   по умолчанию выровненная по кэш-линии
+ * - Раскладка в памяти задаётся политикой: построчная (RowMajor), плитками (Tiled)
+ *   или в Z-порядке (Morton) для запросов по двумерной окрестности
  */
 
 #ifndef MATRIX_HPP
@@ -14,14 +19,254 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <initializer_list>
 
-template<typename T>
+/**
+ * @brief Аллокатор с выравниванием блока по Alignment байт
+ *
+ * По умолчанию выравнивание - кэш-линия (64 байта, один регистр AVX-512),
+ * поэтому строки матрицы не делят кэш-линию с чужими данными и читаются векторными инструкциями
+ *
+ * @tparam T Тип элементов
+ * @tparam Alignment Выравнивание в байтах, степень двойки
+ */
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "AlignedAllocator: alignment must be a power of two");
+
+public:
+    using value_type = T;
+
+    static constexpr std::size_t alignment = Alignment < alignof(T) ? alignof(T) : Alignment;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        ::operator delete(p, n * sizeof(T), std::align_val_t(alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/**
+ * @brief Выравнивание данных матрицы в байтах
+ *
+ * Гарантируется для AlignedAllocator и std::pmr::polymorphic_allocator,
+ * другие аллокаторы выравнивают по своим правилам
+ */
+inline constexpr std::size_t matrix_alignment = 64;
+
+/**
+ * @brief Политика проверки границ: operator[][] бросает std::out_of_range
+ */
+struct CheckedBounds {
+    static constexpr bool enabled = true;
+};
+
+/**
+ * @brief Политика без проверки границ: operator[][] - просто адресная арифметика
+ *
+ * Выход за границы - неопределённое поведение, как у указателя
+ */
+struct UncheckedBounds {
+    static constexpr bool enabled = false;
+};
+
+#ifndef MATRIX_BOUNDS_CHECK
+/**
+ * @brief Проверять ли границы в operator[][] по умолчанию
+ *
+ * Если не задано при сборке: в отладочной сборке проверять, с NDEBUG - нет
+ */
+#ifdef NDEBUG
+#define MATRIX_BOUNDS_CHECK 0
+#else
+#define MATRIX_BOUNDS_CHECK 1
+#endif
+#endif
+
+/**
+ * @brief Политика проверки границ operator[][] по умолчанию (см. MATRIX_BOUNDS_CHECK)
+ */
+using DefaultBoundsCheck = std::conditional_t<MATRIX_BOUNDS_CHECK != 0, CheckedBounds, UncheckedBounds>;
+
+namespace matrix_detail {
+    template<typename Allocator>
+    struct is_polymorphic_allocator : std::false_type {};
+
+    template<typename U>
+    struct is_polymorphic_allocator<std::pmr::polymorphic_allocator<U>> : std::true_type {};
+
+    // Аллокаторы без собственного construct: для них подходят стандартные uninitialized-алгоритмы
+    template<typename Allocator>
+    struct has_plain_construct : std::false_type {};
+
+    template<typename U>
+    struct has_plain_construct<std::allocator<U>> : std::true_type {};
+
+    template<typename U, std::size_t Alignment>
+    struct has_plain_construct<AlignedAllocator<U, Alignment>> : std::true_type {};
+}
+
+/**
+ * @brief Построчная раскладка (row-major): [0][0], [0][1], ..., [1][0], ...
+ *
+ * Раскладка по умолчанию. Строки непрерывны, поэтому доступны row_span, а итератор идёт
+ * по указателю и перескакивает запас ёмкости только в конце строки
+ */
+struct RowMajor {
+    struct mapping {
+        static constexpr bool contiguous_rows = true;
+
+        std::size_t rows = 0;
+        std::size_t stride = 0;
+
+        mapping() = default;
+        mapping(int rows, int cols) : rows(rows), stride(cols) {}
+
+        std::size_t required_size() const noexcept { return rows * stride; }
+
+        std::size_t operator()(int i, int j) const noexcept {
+            return static_cast<std::size_t>(i) * stride + static_cast<std::size_t>(j);
+        }
+    };
+};
+
+/**
+ * @brief Раскладка квадратными плитками Block x Block
+ *
+ * Плитки идут построчно, внутри плитки ячейки тоже построчно. Соседи по вертикали
+ * лежат в пределах одной плитки, поэтому обход окрестности затрагивает несколько кэш-линий,
+ * а не по линии на каждую строку. Размеры дополняются до кратных Block
+ *
+ * @tparam Block Сторона плитки, степень двойки
+ */
+template<int Block = 16>
+struct Tiled {
+    static_assert(Block > 0 && (Block & (Block - 1)) == 0, "Tiled: block size must be a power of two");
+
+    struct mapping {
+        static constexpr bool contiguous_rows = false;
+        static constexpr int shift = std::countr_zero(static_cast<unsigned>(Block));
+        static constexpr std::size_t mask = Block - 1;
+
+        std::size_t tile_rows = 0;
+        std::size_t tiles_per_row = 0;
+
+        mapping() = default;
+        mapping(int rows, int cols)
+            : tile_rows((static_cast<std::size_t>(rows) + mask) >> shift),
+              tiles_per_row((static_cast<std::size_t>(cols) + mask) >> shift) {}
+
+        std::size_t required_size() const noexcept { return (tile_rows * tiles_per_row) << (2 * shift); }
+
+        std::size_t operator()(int i, int j) const noexcept {
+            std::size_t row = static_cast<std::size_t>(i);
+            std::size_t col = static_cast<std::size_t>(j);
+            std::size_t tile = (row >> shift) * tiles_per_row + (col >> shift);
+            return (tile << (2 * shift)) | ((row & mask) << shift) | (col & mask);
+        }
+    };
+};
+
+/**
+ * @brief Раскладка в Z-порядке (Morton): биты номеров строки и столбца чередуются
+ *
+ * Близкие по обеим координатам ячейки близки в памяти на всех масштабах.
+ * Каждая сторона дополняется до степени двойки; у прямоугольной матрицы
+ * старшие биты длинной стороны идут поверх квадратного Z-блока
+ */
+struct Morton {
+    struct mapping {
+        static constexpr bool contiguous_rows = false;
+
+        int low_bits = 0;
+        bool rows_longer = false;
+        std::size_t size = 0;
+
+        mapping() = default;
+        mapping(int rows, int cols) {
+            if (rows <= 0 || cols <= 0) {
+                return;
+            }
+            int row_bits = std::bit_width(static_cast<unsigned>(rows - 1));
+            int col_bits = std::bit_width(static_cast<unsigned>(cols - 1));
+            low_bits = std::min(row_bits, col_bits);
+            rows_longer = row_bits > col_bits;
+            size = std::size_t(1) << (row_bits + col_bits);
+        }
+
+        std::size_t required_size() const noexcept { return size; }
+
+        /**
+         * @brief Раздвигает биты x через один: b1 b0 -> b1 0 b0
+         */
+        static constexpr std::uint64_t spread_bits(std::uint32_t x) noexcept {
+            std::uint64_t v = x;
+            v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+            v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+            v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+            v = (v | (v << 2)) & 0x3333333333333333ull;
+            v = (v | (v << 1)) & 0x5555555555555555ull;
+            return v;
+        }
+
+        std::size_t operator()(int i, int j) const noexcept {
+            std::uint32_t row = static_cast<std::uint32_t>(i);
+            std::uint32_t col = static_cast<std::uint32_t>(j);
+            std::uint32_t low_mask = (std::uint32_t(1) << low_bits) - 1;
+            std::uint64_t low = (spread_bits(row & low_mask) << 1) | spread_bits(col & low_mask);
+            std::uint64_t high = (rows_longer ? row : col) >> low_bits;
+            return static_cast<std::size_t>((high << (2 * low_bits)) | low);
+        }
+    };
+};
+
+template<typename T, typename Allocator = AlignedAllocator<T>, typename BoundsCheck = DefaultBoundsCheck,
+         typename Layout = RowMajor>
 class Matrix;
 
+/**
+ * @brief Матрица, память которой выделяется из std::pmr::memory_resource (например, арены)
+ */
 template<typename T>
+using PmrMatrix = Matrix<T, std::pmr::polymorphic_allocator<T>>;
+
+template<typename T, typename BoundsCheck = DefaultBoundsCheck, typename Mapping = RowMajor::mapping>
 class MatrixRow;
 
 /**
@@ -29,75 +274,217 @@ class MatrixRow;
  * @brief Итератор с произвольным доступом для Matrix
  * 
  * Обходит матрицу построчно (row-major order): [0][0], [0][1], ..., [1][0], ...
+ * независимо от раскладки и запаса ёмкости: координаты (i, j) пересчитываются
+ * в смещение раскладки Mapping, ячейки дополнения и запаса пропускаются.
+ * Хранит координаты, а не номер ячейки, поэтому ++ и -- обходятся без деления.
+ * Для построчной раскладки есть специализация, которая идёт по указателю.
  * Поддерживает все операции RandomAccessIterator из STL
  */
 
-template<typename T>
+template<typename T, typename Mapping = RowMajor::mapping>
 class MatrixIterator {
 public:
     using iterator_category = std::random_access_iterator_tag;
-    using value_type = T;
+    using value_type = std::remove_const_t<T>;
     using difference_type = std::ptrdiff_t;
     using pointer = T*;
     using reference = T&;
 
 private:
-    pointer ptr_; 
+    pointer base_ = nullptr;
+    Mapping mapping_;
+    int cols_ = 0;
+    int i_ = 0;
+    int j_ = 0;
+
+    difference_type index() const {
+        return static_cast<difference_type>(i_) * cols_ + j_;
+    }
+
+    void seek(difference_type k) {
+        i_ = cols_ == 0 ? 0 : static_cast<int>(k / cols_);
+        j_ = cols_ == 0 ? 0 : static_cast<int>(k % cols_);
+    }
+
 public:
-    MatrixIterator() : ptr_(nullptr) {}
-    explicit MatrixIterator(pointer p) : ptr_(p) {}
-    
-    MatrixIterator(const MatrixIterator&) = default;
-    MatrixIterator& operator=(const MatrixIterator&) = default;
+    MatrixIterator() = default;
+    MatrixIterator(pointer base, const Mapping& mapping, int cols, difference_type k)
+        : base_(base), mapping_(mapping), cols_(cols) {
+        seek(k);
+    }
     
-    reference operator*() const { return *ptr_; }
-    pointer operator->() const { return ptr_; }
-    reference operator[](difference_type n) const { return ptr_[n]; }
+    reference operator*() const { return base_[mapping_(i_, j_)]; }
+    pointer operator->() const { return base_ + mapping_(i_, j_); }
+    reference operator[](difference_type n) const { return *(*this + n); }
     
     MatrixIterator& operator++() {
-        ++ptr_;
+        if (++j_ == cols_) {
+            j_ = 0;
+            ++i_;
+        }
         return *this;
     }
     
     MatrixIterator operator++(int) {
         MatrixIterator temp = *this;
-        ++ptr_;
+        ++*this;
         return temp;
     }
     
     MatrixIterator& operator--() {
-        --ptr_;
+        if (j_-- == 0) {
+            j_ = cols_ - 1;
+            --i_;
+        }
         return *this;
     }
     
     MatrixIterator operator--(int) {
         MatrixIterator temp = *this;
-        --ptr_;
+        --*this;
         return temp;
     }
     
     MatrixIterator& operator+=(difference_type n) {
-        ptr_ += n;
+        seek(index() + n);
         return *this;
     }
     
     MatrixIterator& operator-=(difference_type n) {
-        ptr_ -= n;
+        seek(index() - n);
         return *this;
     }
     
     MatrixIterator operator+(difference_type n) const {
-        return MatrixIterator(ptr_ + n);
+        MatrixIterator temp = *this;
+        return temp += n;
     }
     
     MatrixIterator operator-(difference_type n) const {
-        return MatrixIterator(ptr_ - n);
+        MatrixIterator temp = *this;
+        return temp -= n;
     }
     
     difference_type operator-(const MatrixIterator& other) const {
-        return ptr_ - other.ptr_;
+        return index() - other.index();
+    }
+    
+    friend MatrixIterator operator+(difference_type n, const MatrixIterator& it) {
+        return it + n;
     }
     
+    bool operator==(const MatrixIterator& other) const { return index() == other.index(); }
+    bool operator!=(const MatrixIterator& other) const { return index() != other.index(); }
+    bool operator<(const MatrixIterator& other) const { return index() < other.index(); }
+    bool operator>(const MatrixIterator& other) const { return index() > other.index(); }
+    bool operator<=(const MatrixIterator& other) const { return index() <= other.index(); }
+    bool operator>=(const MatrixIterator& other) const { return index() >= other.index(); }
+};
+
+/**
+ * @brief Итератор построчной раскладки
+ *
+ * Ячейки строки лежат подряд, поэтому ++ и * работают с указателем, как у массива,
+ * а запас ёмкости (stride - cols ячеек) перескакивается один раз в конце строки.
+ * Адреса ячеек растут вместе с номером ячейки, поэтому сравнения - это сравнения указателей
+ */
+template<typename T>
+class MatrixIterator<T, RowMajor::mapping> {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+private:
+    pointer base_ = nullptr;
+    pointer ptr_ = nullptr;
+    difference_type stride_ = 0;
+    difference_type cols_ = 0;
+    difference_type j_ = 0;
+
+    difference_type index() const {
+        return cols_ == 0 ? 0 : (ptr_ - j_ - base_) / stride_ * cols_ + j_;
+    }
+
+    void seek(difference_type k) {
+        difference_type i = cols_ == 0 ? 0 : k / cols_;
+        j_ = cols_ == 0 ? 0 : k % cols_;
+        ptr_ = base_ + i * stride_ + j_;
+    }
+
+public:
+    MatrixIterator() = default;
+    MatrixIterator(pointer base, const RowMajor::mapping& mapping, int cols, difference_type k)
+        : base_(base), stride_(static_cast<difference_type>(mapping.stride)), cols_(cols) {
+        seek(k);
+    }
+
+    reference operator*() const { return *ptr_; }
+    pointer operator->() const { return ptr_; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    MatrixIterator& operator++() {
+        ++ptr_;
+        if (++j_ == cols_) {
+            j_ = 0;
+            ptr_ += stride_ - cols_;
+        }
+        return *this;
+    }
+
+    MatrixIterator operator++(int) {
+        MatrixIterator temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    MatrixIterator& operator--() {
+        if (j_-- == 0) {
+            j_ = cols_ - 1;
+            ptr_ -= stride_ - cols_;
+        }
+        --ptr_;
+        return *this;
+    }
+
+    MatrixIterator operator--(int) {
+        MatrixIterator temp = *this;
+        --*this;
+        return temp;
+    }
+
+    MatrixIterator& operator+=(difference_type n) {
+        if (stride_ == cols_) {
+            ptr_ += n;
+            j_ = cols_ == 0 ? 0 : (ptr_ - base_) % cols_;
+        } else {
+            seek(index() + n);
+        }
+        return *this;
+    }
+
+    MatrixIterator& operator-=(difference_type n) { return *this += -n; }
+
+    MatrixIterator operator+(difference_type n) const {
+        MatrixIterator temp = *this;
+        return temp += n;
+    }
+
+    MatrixIterator operator-(difference_type n) const {
+        MatrixIterator temp = *this;
+        return temp -= n;
+    }
+
+    difference_type operator-(const MatrixIterator& other) const {
+        return stride_ == cols_ ? ptr_ - other.ptr_ : index() - other.index();
+    }
+
+    friend MatrixIterator operator+(difference_type n, const MatrixIterator& it) {
+        return it + n;
+    }
+
     bool operator==(const MatrixIterator& other) const { return ptr_ == other.ptr_; }
     bool operator!=(const MatrixIterator& other) const { return ptr_ != other.ptr_; }
     bool operator<(const MatrixIterator& other) const { return ptr_ < other.ptr_; }
@@ -106,43 +493,46 @@ public:
     bool operator>=(const MatrixIterator& other) const { return ptr_ >= other.ptr_; }
 };
 
-template<typename T>
-MatrixIterator<T> operator+(typename MatrixIterator<T>::difference_type n,
-                            const MatrixIterator<T>& it) {
-    return it + n;
-}
-
 /**
  * @brief Прокси-класс для реализации синтаксиса matrix[i][j]
  * 
  * Возвращается оператором [] матрицы и предоставляет второй []
- * для доступа к конкретной ячейке строки
+ * для доступа к конкретной ячейке строки. Индекс столбца проверяется,
+ * только если этого требует политика BoundsCheck. Смещение ячейки
+ * вычисляет раскладка Mapping (для построчной - row * stride + j)
  */
 
-template<typename T>
+template<typename T, typename BoundsCheck, typename Mapping>
 class MatrixRow {
 private:
-    T* row_ptr_;
+    T* base_;
+    Mapping mapping_;
+    int row_;
     int cols_;
    
-    template<typename U>
+    template<typename U, typename A, typename B, typename L>
     friend class Matrix;
     
-    MatrixRow(T* ptr, int cols) : row_ptr_(ptr), cols_(cols) {}
+    MatrixRow(T* base, const Mapping& mapping, int row, int cols)
+        : base_(base), mapping_(mapping), row_(row), cols_(cols) {}
 
 public:
     T& operator[](int j) {
-        if (j < 0 || j >= cols_) {
-            throw std::out_of_range("Matrix: column index out of range");
+        if constexpr (BoundsCheck::enabled) {
+            if (j < 0 || j >= cols_) {
+                throw std::out_of_range("Matrix: column index out of range");
+            }
         }
-        return row_ptr_[j];
+        return base_[mapping_(row_, j)];
     }
     
     const T& operator[](int j) const {
-        if (j < 0 || j >= cols_) {
-            throw std::out_of_range("Matrix: column index out of range");
+        if constexpr (BoundsCheck::enabled) {
+            if (j < 0 || j >= cols_) {
+                throw std::out_of_range("Matrix: column index out of range");
+            }
         }
-        return row_ptr_[j];
+        return base_[mapping_(row_, j)];
     }
 };
 
@@ -150,19 +540,32 @@ public:
  * @brief Шаблонный контейнер для двумерных матриц
  * 
  * Особенности реализации:
- * - Хранение в виде одномерного массива (row-major order) для непрерывности памяти
- * - Поддержка синтаксиса matrix[i][j] через прокси-класс MatrixRow
+ * - Хранение в виде одномерного массива (row-major order): строки непрерывны,
+ *   соседние строки отстоят на get_stride() ячеек
+ * - Память выделяется аллокатором, элементы конструируются прямо в ней за один проход
+ * - Запас ёмкости по строкам и столбцам, как у std::vector: resize в пределах ёмкости
+ *   не переносит ячейки, а рост ёмкости геометрический
+ * - Поддержка синтаксиса matrix[i][j] через прокси-класс MatrixRow,
+ *   проверка границ в нём задаётся политикой BoundsCheck
+ * - Доступ без проверок для горячих циклов: operator()(i, j) и row_span(i)
  * - Совместимость с STL (итераторы, алгоритмы)
  * - RAII для автоматического управления памятью
  * - Move-семантика для эффективного перемещения
  * 
  * @tparam T Тип элементов матрицы
+ * @tparam Allocator Аллокатор элементов, по умолчанию выровненный по кэш-линии
+ * @tparam BoundsCheck CheckedBounds или UncheckedBounds для operator[][]
+ * @tparam Layout Раскладка в памяти: RowMajor, Tiled<Block> или Morton
  */
 
-template<typename T>
+template<typename T, typename Allocator, typename BoundsCheck, typename Layout>
 class Matrix {
+    static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, T>,
+                  "Matrix: Allocator::value_type must be T");
+
 public:
     using value_type = T;
+    using allocator_type = Allocator;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using reference = T&;
@@ -170,64 +573,502 @@ public:
     using pointer = T*;
     using const_pointer = const T*;
     
-    using iterator = MatrixIterator<T>;
-    using const_iterator = MatrixIterator<const T>;
+    using layout_type = Layout;
+    using mapping_type = typename Layout::mapping;
+    
+    using iterator = MatrixIterator<T, mapping_type>;
+    using const_iterator = MatrixIterator<const T, mapping_type>;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
 private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    [[no_unique_address]] Allocator alloc_;
     T* data_;     // Указатель на одномерный массив данных
     int rows_;    // Количество строк
     int cols_;    // Количество столбцов
+    int row_capacity_;  // Число строк, под которые выделена память
+    int col_capacity_;  // Число столбцов, под которые выделена память
+    mapping_type mapping_;  // Смещение ячейки (i, j) в data_, строится по ёмкости
     
     /**
-     * @brief Выделяет память для матрицы
+     * @brief Число ячеек в памяти, включая запас ёмкости и дополнение раскладки до целых плиток
+     *
+     * Сконструированы только ячейки (i, j) при i < rows_, j < cols_
      */
-
-    void allocate() {
-        if (rows_ > 0 && cols_ > 0) {
-            data_ = new T[rows_ * cols_];
+    size_type storage_size() const noexcept { return mapping_.required_size(); }
+    
+    /**
+     * @brief Выделяет сырую память под n элементов
+     *
+     * polymorphic_allocator просит у ресурса выравнивание matrix_alignment,
+     * остальные аллокаторы выравнивают сами
+     */
+    T* allocate_storage(size_type n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        if constexpr (matrix_detail::is_polymorphic_allocator<Allocator>::value) {
+            if (n > static_cast<size_type>(-1) / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T*>(alloc_.allocate_bytes(n * sizeof(T), std::max(matrix_alignment, alignof(T))));
+        } else {
+            return alloc_traits::allocate(alloc_, n);
+        }
+    }
+    
+    /**
+     * @brief Возвращает сырую память аллокатору
+     */
+    void deallocate_storage(T* p, size_type n) noexcept {
+        if (p == nullptr) {
+            return;
+        }
+        if constexpr (matrix_detail::is_polymorphic_allocator<Allocator>::value) {
+            alloc_.deallocate_bytes(p, n * sizeof(T), std::max(matrix_alignment, alignof(T)));
+        } else {
+            alloc_traits::deallocate(alloc_, p, n);
+        }
+    }
+    
+    /**
+     * @brief Уничтожает n элементов, начиная с first
+     */
+    void destroy_n(T* first, size_type n) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type k = 0; k < n; ++k) {
+                alloc_traits::destroy(alloc_, first + k);
+            }
+        }
+    }
+    
+    /**
+     * @brief Конструирует n элементов в сырой памяти: make(p) создаёт элемент по адресу p
+     *
+     * Если конструктор бросает исключение, уже созданные элементы уничтожаются
+     */
+    template<typename Make>
+    void construct_n(T* first, size_type n, Make make) {
+        size_type k = 0;
+        try {
+            for (; k < n; ++k) {
+                make(first + k);
+            }
+        } catch (...) {
+            destroy_n(first, k);
+            throw;
+        }
+    }
+    
+    /**
+     * @brief Создаёт n элементов T() в сырой памяти
+     *
+     * Элемент конструируется один раз прямо на месте, без последующего присваивания
+     */
+    void value_construct_n(T* first, size_type n) {
+        if constexpr (matrix_detail::has_plain_construct<Allocator>::value) {
+            std::uninitialized_value_construct_n(first, n);
+        } else {
+            construct_n(first, n, [this](T* p) { alloc_traits::construct(alloc_, p); });
+        }
+    }
+    
+    /**
+     * @brief Создаёт n копий value в сырой памяти
+     */
+    void fill_construct_n(T* first, size_type n, const T& value) {
+        if constexpr (matrix_detail::has_plain_construct<Allocator>::value) {
+            std::uninitialized_fill_n(first, n, value);
+        } else {
+            construct_n(first, n, [this, &value](T* p) { alloc_traits::construct(alloc_, p, value); });
+        }
+    }
+    
+    /**
+     * @brief Создаёт копии n элементов source в сырой памяти
+     */
+    void copy_construct_n(const T* source, size_type n, T* first) {
+        if constexpr (matrix_detail::has_plain_construct<Allocator>::value) {
+            std::uninitialized_copy_n(source, n, first);
         } else {
-            data_ = nullptr;
+            construct_n(first, n, [this, source, first](T* p) { alloc_traits::construct(alloc_, p, source[p - first]); });
+        }
+    }
+    
+    /**
+     * @brief Перемещает n элементов source в сырую память (копирует, если перемещение может бросить)
+     */
+    void move_construct_n(T* source, size_type n, T* first) {
+        construct_n(first, n, [this, source, first](T* p) {
+            alloc_traits::construct(alloc_, p, std::move_if_noexcept(source[p - first]));
+        });
+    }
+    
+    /**
+     * @brief Создаёт n элементов, которые сразу будут перезаписаны присваиванием
+     *
+     * Тривиальные типы обычного аллокатора не инициализируются вовсе, остальные - как T()
+     */
+    void construct_for_overwrite_n(T* first, size_type n) {
+        if constexpr (std::is_trivially_default_constructible_v<T> &&
+                      matrix_detail::has_plain_construct<Allocator>::value) {
+            std::uninitialized_default_construct_n(first, n);
+        } else {
+            value_construct_n(first, n);
+        }
+    }
+    
+    /**
+     * @brief Уничтожает ячейки прямоугольника строк [r0, r1) и столбцов [c0, c1)
+     */
+    void destroy_cells(T* base, const mapping_type& mapping, int r0, int r1, int c0, int c1) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (int i = r0; i < r1; ++i) {
+                for (int j = c0; j < c1; ++j) {
+                    alloc_traits::destroy(alloc_, base + mapping(i, j));
+                }
+            }
         }
     }
     
     /**
-     * @brief Освобождает память
+     * @brief Конструирует ячейки прямоугольника строк [r0, r1) и столбцов [c0, c1)
+     *
+     * fill(p, i, j, n) создаёт n ячеек строки i, начиная со столбца j, по адресу p:
+     * у раскладок с непрерывными строками - одним вызовом на строку, иначе по одной ячейке.
+     * Если конструктор бросает исключение, уже созданные ячейки уничтожаются
      */
-    void deallocate() {
-        delete[] data_;
+    template<typename Fill>
+    void construct_cells(T* base, const mapping_type& mapping, int r0, int r1, int c0, int c1, Fill fill) {
+        if (c0 >= c1) {
+            return;
+        }
+        int i = r0;
+        try {
+            for (; i < r1; ++i) {
+                if constexpr (mapping_type::contiguous_rows) {
+                    fill(base + mapping(i, c0), i, c0, static_cast<size_type>(c1 - c0));
+                } else {
+                    int j = c0;
+                    try {
+                        for (; j < c1; ++j) {
+                            fill(base + mapping(i, j), i, j, size_type(1));
+                        }
+                    } catch (...) {
+                        destroy_cells(base, mapping, i, i + 1, c0, j);
+                        throw;
+                    }
+                }
+            }
+        } catch (...) {
+            destroy_cells(base, mapping, r0, i, c0, c1);
+            throw;
+        }
+    }
+    
+    /**
+     * @brief Выделяет память ровно под rows x cols и конструирует все ячейки через fill
+     *
+     * При исключении память освобождается, матрица остаётся пустой
+     */
+    template<typename Fill>
+    void create(int rows, int cols, Fill fill) {
+        mapping_type mapping(rows, cols);
+        T* data = allocate_storage(mapping.required_size());
+        try {
+            construct_cells(data, mapping, 0, rows, 0, cols, fill);
+        } catch (...) {
+            deallocate_storage(data, mapping.required_size());
+            throw;
+        }
+        data_ = data;
+        rows_ = rows;
+        cols_ = cols;
+        row_capacity_ = rows;
+        col_capacity_ = cols;
+        mapping_ = mapping;
+    }
+    
+    /**
+     * @brief Уничтожает элементы, освобождает память и оставляет матрицу пустой (0x0)
+     */
+    void deallocate() noexcept {
+        destroy_cells(data_, mapping_, 0, rows_, 0, cols_);
+        deallocate_storage(data_, storage_size());
         data_ = nullptr;
+        rows_ = 0;
+        cols_ = 0;
+        row_capacity_ = 0;
+        col_capacity_ = 0;
+        mapping_ = mapping_type();
+    }
+    
+    /**
+     * @brief Проверяет размеры, переданные в конструктор или resize
+     */
+    static void check_dimensions(int rows, int cols) {
+        if (rows < 0 || cols < 0) {
+            throw std::invalid_argument("Matrix: dimensions must be non-negative");
+        }
+    }
+    
+    /**
+     * @brief Ёмкость, которой хватит на required при текущей current: рост хотя бы вдвое
+     */
+    static int grow_capacity(int current, int required) noexcept {
+        if (required <= current) {
+            return current;
+        }
+        if (current > std::numeric_limits<int>::max() / 2) {
+            return required;
+        }
+        return std::max(required, 2 * current);
+    }
+    
+    /**
+     * @brief Забирает память другой матрицы того же аллокатора, оставляя её пустой
+     */
+    void take(Matrix& other) noexcept {
+        data_ = std::exchange(other.data_, nullptr);
+        rows_ = std::exchange(other.rows_, 0);
+        cols_ = std::exchange(other.cols_, 0);
+        row_capacity_ = std::exchange(other.row_capacity_, 0);
+        col_capacity_ = std::exchange(other.col_capacity_, 0);
+        mapping_ = std::exchange(other.mapping_, mapping_type());
+    }
+    
+    /**
+     * @brief Переносит ячейки в новую память ёмкостью row_capacity x col_capacity
+     *
+     * Сохраняемые ячейки перемещаются, ячейки за пределами old-размеров до new_rows x new_cols
+     * создаются через fill. При исключении матрица не меняется
+     */
+    template<typename Fill>
+    void relocate(int row_capacity, int col_capacity, int new_rows, int new_cols, Fill fill) {
+        mapping_type mapping(row_capacity, col_capacity);
+        T* data = allocate_storage(mapping.required_size());
+        int kept_rows = std::min(rows_, new_rows);
+        int kept_cols = std::min(cols_, new_cols);
+        int step = 0;
+        try {
+            construct_cells(data, mapping, 0, kept_rows, 0, kept_cols, [this](T* p, int i, int j, size_type n) {
+                move_construct_n(data_ + linear_index(i, j), n, p);
+            });
+            ++step;
+            construct_cells(data, mapping, 0, kept_rows, kept_cols, new_cols, fill);
+            ++step;
+            construct_cells(data, mapping, kept_rows, new_rows, 0, new_cols, fill);
+        } catch (...) {
+            if (step > 1) {
+                destroy_cells(data, mapping, 0, kept_rows, kept_cols, new_cols);
+            }
+            if (step > 0) {
+                destroy_cells(data, mapping, 0, kept_rows, 0, kept_cols);
+            }
+            deallocate_storage(data, mapping.required_size());
+            throw;
+        }
+        
+        deallocate();
+        data_ = data;
+        rows_ = new_rows;
+        cols_ = new_cols;
+        row_capacity_ = row_capacity;
+        col_capacity_ = col_capacity;
+        mapping_ = mapping;
+    }
+    
+    /**
+     * @brief Общая часть обоих resize: новые ячейки создаёт fill, старые не трогаются
+     *
+     * В пределах ёмкости ячейки остаются на месте: создаются только открывшиеся,
+     * уничтожаются только отрезанные. Иначе ёмкость растёт геометрически и ячейки переносятся
+     */
+    template<typename Fill>
+    void resize_with(int new_rows, int new_cols, Fill fill) {
+        check_dimensions(new_rows, new_cols);
+        
+        if (new_rows == rows_ && new_cols == cols_) {
+            return;
+        }
+        
+        if (new_rows > row_capacity_ || new_cols > col_capacity_) {
+            relocate(grow_capacity(row_capacity_, new_rows), grow_capacity(col_capacity_, new_cols),
+                     new_rows, new_cols, fill);
+            return;
+        }
+        
+        int kept_rows = std::min(rows_, new_rows);
+        construct_cells(data_, mapping_, 0, kept_rows, cols_, new_cols, fill);
+        try {
+            construct_cells(data_, mapping_, rows_, new_rows, 0, new_cols, fill);
+        } catch (...) {
+            destroy_cells(data_, mapping_, 0, kept_rows, cols_, new_cols);
+            throw;
+        }
+        destroy_cells(data_, mapping_, 0, kept_rows, new_cols, cols_);
+        destroy_cells(data_, mapping_, new_rows, rows_, 0, cols_);
+        rows_ = new_rows;
+        cols_ = new_cols;
+    }
+    
+    /**
+     * @brief Итератор на ячейку номер k в построчном порядке
+     */
+    template<typename Iterator, typename Pointer>
+    Iterator make_iterator(Pointer base, size_type k) const {
+        return Iterator(base, mapping_, cols_, static_cast<difference_type>(k));
+    }
+    
+    /**
+     * @brief Проверяет индекс строки, если Enabled
+     */
+    template<bool Enabled>
+    void check_row(int i) const {
+        if constexpr (Enabled) {
+            if (i < 0 || i >= rows_) {
+                throw std::out_of_range("Matrix: row index out of range");
+            }
+        }
     }
     
     /**
      * @brief Вычисляет линейный индекс из двумерных координат
      */
-    inline int linear_index(int i, int j) const {
-        return i * cols_ + j;
+    inline size_type linear_index(int i, int j) const noexcept {
+        return mapping_(i, j);
+    }
+    
+    /**
+     * @brief Сторона квадратной плитки блочного транспонирования
+     *
+     * Плитка источника и плитка результата вместе помещаются в L1 даже для 8-байтных ячеек
+     */
+    static constexpr int transpose_block = 32;
+    
+    /**
+     * @brief Транспонирует в result полосу строк [band, band + transpose_block)
+     *
+     * Плитка читается по строкам, а пишется по столбцам, но все её строки в результате
+     * остаются в кэше до конца плитки, так что каждая кэш-линия загружается один раз
+     */
+    void transpose_band(Matrix& result, int band) const {
+        int band_end = std::min(band + transpose_block, rows_);
+        for (int tile = 0; tile < cols_; tile += transpose_block) {
+            int tile_end = std::min(tile + transpose_block, cols_);
+            for (int i = band; i < band_end; ++i) {
+                for (int j = tile; j < tile_end; ++j) {
+                    result(j, i) = (*this)(i, j);
+                }
+            }
+        }
+    }
+    
+    /**
+     * @brief Меняет местами плитки полосы band с симметричными им плитками над диагональю
+     *
+     * Плитка на диагонали транспонируется сама в себе, остальные - обменом с парной
+     */
+    void transpose_band_in_place(int band) {
+        using std::swap;
+        int band_end = std::min(band + transpose_block, rows_);
+        for (int tile = band; tile < cols_; tile += transpose_block) {
+            int tile_end = std::min(tile + transpose_block, cols_);
+            for (int i = band; i < band_end; ++i) {
+                for (int j = std::max(tile, i + 1); j < tile_end; ++j) {
+                    swap((*this)(i, j), (*this)(j, i));
+                }
+            }
+        }
+    }
+    
+    /**
+     * @brief Вызывает body(band) для каждой полосы плиток в threads потоках
+     *
+     * Полосы раздаются через одну (поток t берёт t, t + threads, ...), так что и треугольник
+     * транспонирования на месте делится примерно поровну. Если поток создать не удалось,
+     * его полосы обрабатывает вызывающий поток. Исключение из body передаётся вызывающему
+     * после завершения всех потоков
+     */
+    template<typename Body>
+    void for_each_band(unsigned threads, Body body) const {
+        int bands = (rows_ + transpose_block - 1) / transpose_block;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, static_cast<unsigned>(std::max(bands, 1)));
+        
+        std::vector<std::exception_ptr> errors(threads);
+        auto work = [&](unsigned t) {
+            try {
+                for (int k = static_cast<int>(t); k < bands; k += static_cast<int>(threads)) {
+                    body(k * transpose_block);
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+        
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        unsigned started = 1;
+        try {
+            for (; started < threads; ++started) {
+                workers.emplace_back(work, started);
+            }
+        } catch (const std::system_error&) {
+        }
+        work(0);
+        for (unsigned t = started; t < threads; ++t) {
+            work(t);
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+    
+    /**
+     * @brief Пустая матрица cols_ x rows_, ячейки которой сразу перезапишет транспонирование
+     */
+    Matrix transposed_storage() const {
+        Matrix result(get_allocator());
+        result.create(cols_, rows_, [&result](T* p, int, int, size_type n) { result.construct_for_overwrite_n(p, n); });
+        return result;
     }
 
 public:
      /**
      * @brief Конструктор по умолчанию - создаёт пустую матрицу 0x0
      */
-    Matrix() : data_(nullptr), rows_(0), cols_(0) {}
+    Matrix() noexcept(noexcept(Allocator())) : Matrix(Allocator()) {}
+    
+    /**
+     * @brief Конструктор пустой матрицы с заданным аллокатором
+     */
+    explicit Matrix(const Allocator& alloc) noexcept
+        : alloc_(alloc), data_(nullptr), rows_(0), cols_(0), row_capacity_(0), col_capacity_(0) {}
     
     /**
      * @brief Конструктор с размерами - создаёт матрицу rows x cols
      * 
-     * Элементы инициализируются значением по умолчанию T()
+     * Элементы инициализируются значением по умолчанию T() за один проход по памяти
      * 
      * @param rows Количество строк
      * @param cols Количество столбцов
+     * @param alloc Аллокатор
      * @throws std::invalid_argument если размеры отрицательные
      */
-    Matrix(int rows, int cols) : data_(nullptr), rows_(rows), cols_(cols) {
-        if (rows < 0 || cols < 0) {
-            throw std::invalid_argument("Matrix: dimensions must be non-negative");
-        }
-        allocate();
-        std::fill_n(data_, rows_ * cols_, T());
+    Matrix(int rows, int cols, const Allocator& alloc = Allocator()) : Matrix(alloc) {
+        check_dimensions(rows, cols);
+        create(rows, cols, [this](T* p, int, int, size_type n) { value_construct_n(p, n); });
     }
     
     /**
@@ -238,26 +1079,29 @@ public:
      * @param rows Количество строк
      * @param cols Количество столбцов
      * @param value Значение для инициализации
+     * @param alloc Аллокатор
      * @throws std::invalid_argument если размеры отрицательные
      */
-    Matrix(int rows, int cols, const T& value) 
-        : data_(nullptr), rows_(rows), cols_(cols) {
-        if (rows < 0 || cols < 0) {
-            throw std::invalid_argument("Matrix: dimensions must be non-negative");
-        }
-        allocate();
-        std::fill_n(data_, rows_ * cols_, value);
+    Matrix(int rows, int cols, const T& value, const Allocator& alloc = Allocator()) : Matrix(alloc) {
+        check_dimensions(rows, cols);
+        create(rows, cols, [this, &value](T* p, int, int, size_type n) { fill_construct_n(p, n, value); });
     }
     
     /**
      * @brief Конструктор копирования
      * 
-     * Создаёт глубокую копию матрицы
+     * Создаёт глубокую копию матрицы. Ёмкость копии равна размерам оригинала
      */
-    Matrix(const Matrix& other) 
-        : data_(nullptr), rows_(other.rows_), cols_(other.cols_) {
-        allocate();
-        std::copy(other.data_, other.data_ + rows_ * cols_, data_);
+    Matrix(const Matrix& other)
+        : Matrix(other, alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+    
+    /**
+     * @brief Конструктор копирования с заданным аллокатором
+     */
+    Matrix(const Matrix& other, const Allocator& alloc) : Matrix(alloc) {
+        create(other.rows_, other.cols_, [this, &other](T* p, int i, int j, size_type n) {
+            copy_construct_n(other.data_ + other.linear_index(i, j), n, p);
+        });
     }
     
     /**
@@ -265,13 +1109,25 @@ public:
      * 
      * Забирает ресурсы у временного объекта без копирования
      */
-    Matrix(Matrix&& other) noexcept
-        : data_(other.data_), rows_(other.rows_), cols_(other.cols_) {
-        other.data_ = nullptr;
-        other.rows_ = 0;
-        other.cols_ = 0;
+    Matrix(Matrix&& other) noexcept : Matrix(std::move(other.alloc_)) {
+        take(other);
     }
     
+    /**
+     * @brief Конструктор перемещения с заданным аллокатором
+     *
+     * Если аллокаторы не равны, элементы перемещаются поштучно в новую память
+     */
+    Matrix(Matrix&& other, const Allocator& alloc) : Matrix(alloc) {
+        if (alloc_ == other.alloc_) {
+            take(other);
+        } else {
+            create(other.rows_, other.cols_, [this, &other](T* p, int i, int j, size_type n) {
+                move_construct_n(other.data_ + other.linear_index(i, j), n, p);
+            });
+        }
+    }
+
     /**
      * @brief Деструктор
      * 
@@ -283,40 +1139,58 @@ public:
     
      /**
      * @brief Оператор копирующего присваивания
+     *
+     * Аллокатор копируется, только если этого требует propagate_on_container_copy_assignment
      */
     Matrix& operator=(const Matrix& other) {
         if (this != &other) {
+            Allocator alloc = alloc_traits::propagate_on_container_copy_assignment::value ? other.alloc_ : alloc_;
+            Matrix copy(other, alloc);
             deallocate();
-            rows_ = other.rows_;
-            cols_ = other.cols_;
-            allocate();
-            std::copy(other.data_, other.data_ + rows_ * cols_, data_);
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                alloc_ = other.alloc_;
+            }
+            take(copy);
         }
         return *this;
     }
     
     /**
      * @brief Оператор перемещающего присваивания
+     *
+     * Память забирается без копирования, если аллокатор переносится или аллокаторы равны,
+     * иначе элементы перемещаются поштучно в память своего аллокатора
      */
-    Matrix& operator=(Matrix&& other) noexcept {
+    Matrix& operator=(Matrix&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                               alloc_traits::is_always_equal::value) {
         if (this != &other) {
-            deallocate();
-            data_ = other.data_;
-            rows_ = other.rows_;
-            cols_ = other.cols_;
-            other.data_ = nullptr;
-            other.rows_ = 0;
-            other.cols_ = 0;
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                deallocate();
+                alloc_ = std::move(other.alloc_);
+                take(other);
+            } else if (alloc_ == other.alloc_) {
+                deallocate();
+                take(other);
+            } else {
+                Matrix moved(std::move(other), alloc_);
+                deallocate();
+                take(moved);
+            }
         }
         return *this;
     }
     
-    iterator begin() { return iterator(data_); }
-    iterator end() { return iterator(data_ + rows_ * cols_); }
-    const_iterator begin() const { return const_iterator(data_); }
-    const_iterator end() const { return const_iterator(data_ + rows_ * cols_); }
-    const_iterator cbegin() const { return const_iterator(data_); }
-    const_iterator cend() const { return const_iterator(data_ + rows_ * cols_); }
+    /**
+     * @brief Аллокатор матрицы
+     */
+    allocator_type get_allocator() const noexcept { return alloc_; }
+    
+    iterator begin() { return make_iterator<iterator>(data_, 0); }
+    iterator end() { return make_iterator<iterator>(data_, size()); }
+    const_iterator begin() const { return make_iterator<const_iterator>(data_, 0); }
+    const_iterator end() const { return make_iterator<const_iterator>(data_, size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
     
     reverse_iterator rbegin() { return reverse_iterator(end()); }
     reverse_iterator rend() { return reverse_iterator(begin()); }
@@ -332,20 +1206,50 @@ public:
      * 
      * @param i Индекс строки
      * @return MatrixRow для доступа к элементам строки
-     * @throws std::out_of_range если индекс строки выходит за границы
+     * @throws std::out_of_range если индекс строки выходит за границы (только с CheckedBounds)
      */
-    MatrixRow<T> operator[](int i) {
-        if (i < 0 || i >= rows_) {
-            throw std::out_of_range("Matrix: row index out of range");
-        }
-        return MatrixRow<T>(data_ + i * cols_, cols_);
+    MatrixRow<T, BoundsCheck, mapping_type> operator[](int i) {
+        check_row<BoundsCheck::enabled>(i);
+        return MatrixRow<T, BoundsCheck, mapping_type>(data_, mapping_, i, cols_);
     }
     
-    const MatrixRow<const T> operator[](int i) const {
-        if (i < 0 || i >= rows_) {
-            throw std::out_of_range("Matrix: row index out of range");
-        }
-        return MatrixRow<const T>(data_ + i * cols_, cols_);
+    const MatrixRow<const T, BoundsCheck, mapping_type> operator[](int i) const {
+        check_row<BoundsCheck::enabled>(i);
+        return MatrixRow<const T, BoundsCheck, mapping_type>(data_, mapping_, i, cols_);
+    }
+    
+    /**
+     * @brief Доступ к элементу без проверки границ при любой политике
+     * 
+     * Для горячих циклов, где индексы заведомо корректны (например, ограничены get_rows()/get_cols())
+     */
+    T& operator()(int i, int j) noexcept { return data_[linear_index(i, j)]; }
+    const T& operator()(int i, int j) const noexcept { return data_[linear_index(i, j)]; }
+    
+    /**
+     * @brief Доступ к элементу с проверкой границ при любой политике
+     * 
+     * @throws std::out_of_range если индексы выходят за границы
+     */
+    T& at(int i, int j) { return get(i, j); }
+    const T& at(int i, int j) const { return get(i, j); }
+    
+    /**
+     * @brief Строка матрицы как непрерывный диапазон
+     * 
+     * Проверяется только индекс строки (по политике BoundsCheck), дальше - обычный std::span.
+     * Есть только у раскладок с непрерывными строками
+     * 
+     * @throws std::out_of_range если индекс строки выходит за границы (только с CheckedBounds)
+     */
+    std::span<T> row_span(int i) requires mapping_type::contiguous_rows {
+        check_row<BoundsCheck::enabled>(i);
+        return std::span<T>(data_ + linear_index(i, 0), static_cast<size_type>(cols_));
+    }
+    
+    std::span<const T> row_span(int i) const requires mapping_type::contiguous_rows {
+        check_row<BoundsCheck::enabled>(i);
+        return std::span<const T>(data_ + linear_index(i, 0), static_cast<size_type>(cols_));
     }
     
     /**
@@ -380,13 +1284,15 @@ public:
     }
     
     /**
-     * @brief Прямой доступ к данным (ContiguousContainer)
+     * @brief Прямой доступ к данным
      * 
-     * Возвращает указатель на начало массива данных
-     * Полезно для взаимодействия с C API или оптимизаций
+     * Возвращает указатель на начало массива данных, nullptr у пустой матрицы
+     * Полезно для взаимодействия с C API или оптимизаций.
+     * Ячейки лежат в порядке раскладки Layout: у RowMajor строка i начинается
+     * с data() + i * get_stride(), у Tiled и Morton - с дополнением
      */
-    T* data() { return data_; }
-    const T* data() const { return data_; }
+    T* data() { return empty() ? nullptr : data_; }
+    const T* data() const { return empty() ? nullptr : data_; }
     
     /**
      * @brief Количество строк матрицы
@@ -401,92 +1307,117 @@ public:
     /**
      * @brief Общее количество элементов (rows * cols)
      */
-    size_type size() const { return static_cast<size_type>(rows_ * cols_); }
+    size_type size() const { return static_cast<size_type>(rows_) * static_cast<size_type>(cols_); }
     
     /**
      * @brief Проверка на пустоту
      */
     bool empty() const { return rows_ == 0 || cols_ == 0; }
     
+    
+    /**
+     * @brief Число строк, под которые выделена память
+     */
+    int get_row_capacity() const { return row_capacity_; }
+    
+    /**
+     * @brief Число столбцов, под которые выделена память
+     */
+    int get_col_capacity() const { return col_capacity_; }
+    
+    /**
+     * @brief Расстояние в ячейках между началами соседних строк в data()
+     *
+     * Равно get_col_capacity(), есть только у построчной раскладки
+     */
+    size_type get_stride() const requires std::is_same_v<Layout, RowMajor> { return mapping_.stride; }
+    
+    /**
+     * @brief Резервирует память под rows x cols без изменения размеров
+     *
+     * Последующие resize в этих пределах не выделяют память и не переносят ячейки.
+     * Ёмкость не уменьшается
+     *
+     * @throws std::invalid_argument если размеры отрицательные
+     */
+    void reserve(int rows, int cols) {
+        check_dimensions(rows, cols);
+        if (rows > row_capacity_ || cols > col_capacity_) {
+            relocate(std::max(rows, row_capacity_), std::max(cols, col_capacity_), rows_, cols_,
+                     [](T*, int, int, size_type) {});
+        }
+    }
+    
+    /**
+     * @brief Освобождает запас ёмкости: память остаётся только под текущие размеры
+     */
+    void shrink_to_fit() {
+        if (row_capacity_ == rows_ && col_capacity_ == cols_) {
+            return;
+        }
+        relocate(rows_, cols_, rows_, cols_, [](T*, int, int, size_type) {});
+    }
+    
     /**
      * @brief Изменяет размер матрицы
      * 
      * Сохраняет существующие данные в пределах новых размеров.
-     * Новые элементы инициализируются значением по умолчанию T().
+     * Новые элементы инициализируются значением по умолчанию T(), старые не трогаются.
+     * Уменьшение и рост в пределах ёмкости не выделяют память и не переносят ячейки;
+     * при нехватке ёмкость растёт хотя бы вдвое, так что рост по шагам - амортизированно O(1)
+     * на новую ячейку
      * 
      * @param new_rows Новое количество строк
      * @param new_cols Новое количество столбцов
      * @throws std::invalid_argument если размеры отрицательные
      */
     void resize(int new_rows, int new_cols) {
-        if (new_rows < 0 || new_cols < 0) {
-            throw std::invalid_argument("Matrix: dimensions must be non-negative");
-        }
-        
-        if (new_rows == rows_ && new_cols == cols_) {
-            return;
-        }
-        
-        T* new_data = nullptr;
-        if (new_rows > 0 && new_cols > 0) {
-            new_data = new T[new_rows * new_cols];
-            
-            std::fill_n(new_data, new_rows * new_cols, T());
-            
-            int copy_rows = std::min(rows_, new_rows);
-            int copy_cols = std::min(cols_, new_cols);
-            
-            for (int i = 0; i < copy_rows; ++i) {
-                std::copy_n(data_ + i * cols_, copy_cols, new_data + i * new_cols);
-            }
-        }
-        
-        deallocate();
-        data_ = new_data;
-        rows_ = new_rows;
-        cols_ = new_cols;
+        resize_with(new_rows, new_cols, [this](T* p, int, int, size_type n) { value_construct_n(p, n); });
     }
     
     /**
      * @brief Изменяет размер с заполнением новых элементов заданным значением
+     *
+     * Новые ячейки сразу создаются копиями value, без промежуточного T()
      */
     void resize(int new_rows, int new_cols, const T& value) {
-        int old_rows = rows_;
-        int old_cols = cols_;
-        resize(new_rows, new_cols);
-        
-        for (int i = 0; i < new_rows; ++i) {
-            for (int j = 0; j < new_cols; ++j) {
-                if (i >= old_rows || j >= old_cols) {
-                    data_[linear_index(i, j)] = value;
-                }
-            }
-        }
+        resize_with(new_rows, new_cols,
+                    [this, &value](T* p, int, int, size_type n) { fill_construct_n(p, n, value); });
     }
     
     /**
-     * @brief Очищает матрицу, делая её пустой (0x0)
+     * @brief Очищает матрицу, делая её пустой (0x0), и освобождает память
      */
     void clear() {
         deallocate();
-        rows_ = 0;
-        cols_ = 0;
     }
     
     /**
      * @brief Обменивает содержимое с другой матрицей за O(1)
      */
     void swap(Matrix& other) noexcept {
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
         std::swap(data_, other.data_);
         std::swap(rows_, other.rows_);
         std::swap(cols_, other.cols_);
+        std::swap(row_capacity_, other.row_capacity_);
+        std::swap(col_capacity_, other.col_capacity_);
+        std::swap(mapping_, other.mapping_);
     }
     
     /**
      * @brief Заполняет всю матрицу заданным значением
      */
     void fill(const T& value) {
-        std::fill_n(data_, rows_ * cols_, value);
+        if constexpr (mapping_type::contiguous_rows) {
+            for (int i = 0; i < rows_; ++i) {
+                std::fill_n(data_ + linear_index(i, 0), cols_, value);
+            }
+        } else {
+            std::fill(begin(), end(), value);
+        }
     }
     
     /**
@@ -499,33 +1430,76 @@ public:
     /**
      * @brief Транспонирование матрицы
      * 
-     * Возвращает новую матрицу - транспонированную копию
+     * Возвращает новую матрицу - транспонированную копию.
+     * Обход идёт плитками transpose_block x transpose_block, чтобы запись по столбцам
+     * результата не вымывала кэш на больших матрицах
      */
-    Matrix<T> transpose() const {
-        Matrix<T> result(cols_, rows_);
-        for (int i = 0; i < rows_; ++i) {
-            for (int j = 0; j < cols_; ++j) {
-                result.data_[j * rows_ + i] = data_[i * cols_ + j];
-            }
+    Matrix transpose() const {
+        Matrix result = transposed_storage();
+        for (int band = 0; band < rows_; band += transpose_block) {
+            transpose_band(result, band);
         }
         return result;
     }
+    
+    /**
+     * @brief Многопоточное транспонирование
+     *
+     * То же, что transpose(), но полосы плиток делятся между потоками.
+     * Копирующее присваивание T должно быть безопасно для разных ячеек из разных потоков
+     *
+     * @param threads Число потоков, 0 - std::thread::hardware_concurrency()
+     */
+    Matrix transpose_parallel(unsigned threads = 0) const {
+        Matrix result = transposed_storage();
+        for_each_band(threads, [this, &result](int band) { transpose_band(result, band); });
+        return result;
+    }
+    
+    /**
+     * @brief Транспонирование квадратной матрицы на месте, без выделения памяти
+     *
+     * @throws std::logic_error если матрица не квадратная
+     */
+    void transpose_in_place() {
+        if (rows_ != cols_) {
+            throw std::logic_error("Matrix: in-place transpose requires a square matrix");
+        }
+        for (int band = 0; band < rows_; band += transpose_block) {
+            transpose_band_in_place(band);
+        }
+    }
+    
+    /**
+     * @brief Многопоточное транспонирование квадратной матрицы на месте
+     *
+     * @param threads Число потоков, 0 - std::thread::hardware_concurrency()
+     * @throws std::logic_error если матрица не квадратная
+     */
+    void transpose_in_place_parallel(unsigned threads = 0) {
+        if (rows_ != cols_) {
+            throw std::logic_error("Matrix: in-place transpose requires a square matrix");
+        }
+        for_each_band(threads, [this](int band) { transpose_band_in_place(band); });
+    }
 };
 
 
 /**
  * @brief Внешняя функция swap для ADL (Argument Dependent Lookup)
  */
-template<typename T>
-void swap(Matrix<T>& lhs, Matrix<T>& rhs) noexcept {
+template<typename T, typename Allocator, typename BoundsCheck, typename Layout>
+void swap(Matrix<T, Allocator, BoundsCheck, Layout>& lhs,
+          Matrix<T, Allocator, BoundsCheck, Layout>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 /**
  * @brief Оператор сравнения на равенство
  */
-template<typename T>
-bool operator==(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+template<typename T, typename Allocator, typename BoundsCheck, typename Layout>
+bool operator==(const Matrix<T, Allocator, BoundsCheck, Layout>& lhs,
+                const Matrix<T, Allocator, BoundsCheck, Layout>& rhs) {
     if (lhs.get_rows() != rhs.get_rows() || lhs.get_cols() != rhs.get_cols()) {
         return false;
     }
@@ -536,8 +1510,9 @@ bool operator==(const Matrix<T>& lhs, const Matrix<T>& rhs) {
 /**
  * @brief Оператор сравнения на неравенство
  */
-template<typename T>
-bool operator!=(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+template<typename T, typename Allocator, typename BoundsCheck, typename Layout>
+bool operator!=(const Matrix<T, Allocator, BoundsCheck, Layout>& lhs,
+                const Matrix<T, Allocator, BoundsCheck, Layout>& rhs) {
     return !(lhs == rhs);
 }
 
@@ -0,0 +1,246 @@
+/**
+ * @file matrix_bench.cpp
+ * @brief Микробенчмарки Matrix: запросы по окрестности для разных раскладок и транспонирование
+ *
+ * Каждый замер повторяется, пока не наберется --min_time секунд.
+ * Запрос по радиусу - сумма ячеек в круге радиуса R вокруг случайной клетки,
+ * как при расчете видимости и поиске пути.
+ * Время на ячейку нормируется на описанный квадрат (2R + 1)^2.
+ * Транспонирование сравнивается с прежним наивным двойным циклом; размеры 16384
+ * (1 ГиБ на матрицу int) включаются через --max_size=16384.
+ *
+ * Запуск: matrix_bench [--filter=подстрока] [--max_size=N] [--min_time=секунды]
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "../Map/matrix.hpp"
+
+namespace {
+    /**
+     * @brief Запрещает компилятору выбросить вычисление value
+     */
+    template<typename T>
+    void do_not_optimize(const T& value) {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    /**
+     * @brief Ячейка размером с игровую клетку: тип, сущность, предмет
+     */
+    struct BenchCell {
+        std::int32_t type = 0;
+        std::int32_t flags = 0;
+        void* entity = nullptr;
+        void* item = nullptr;
+    };
+
+    int weight(int value) { return value; }
+    int weight(const BenchCell& cell) { return cell.type; }
+
+    /**
+     * @brief Замер: setup готовит данные вне замера и возвращает тело,
+     * которое выполняет n итераций и возвращает число затронутых ячеек
+     */
+    struct Benchmark {
+        std::string name;
+        std::function<std::function<std::size_t(std::size_t)>()> setup;
+    };
+
+    /**
+     * @brief Сумма ячеек в круге радиуса radius вокруг (ci, cj), отсечённом границами карты
+     */
+    template<typename M>
+    long radius_query(const M& map, int ci, int cj, int radius) {
+        long sum = 0;
+        int first_row = std::max(0, ci - radius);
+        int last_row = std::min(map.get_rows() - 1, ci + radius);
+        for (int i = first_row; i <= last_row; ++i) {
+            int di = i - ci;
+            int half = 0;
+            while ((half + 1) * (half + 1) + di * di <= radius * radius) {
+                ++half;
+            }
+            int first_col = std::max(0, cj - half);
+            int last_col = std::min(map.get_cols() - 1, cj + half);
+            for (int j = first_col; j <= last_col; ++j) {
+                sum += weight(map(i, j));
+            }
+        }
+        return sum;
+    }
+
+    template<typename T, typename Layout>
+    void add_radius(std::vector<Benchmark>& benchmarks, const std::string& name, int size, int radius) {
+        benchmarks.push_back({name + "/" + std::to_string(size) + "/r" + std::to_string(radius), [size, radius]() {
+            using M = Matrix<T, AlignedAllocator<T>, UncheckedBounds, Layout>;
+            auto map = std::make_shared<M>(size, size);
+            std::mt19937 generator(1);
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    if constexpr (std::is_same_v<T, int>) {
+                        (*map)(i, j) = static_cast<int>(generator() % 4);
+                    } else {
+                        (*map)(i, j).type = static_cast<int>(generator() % 4);
+                    }
+                }
+            }
+
+            return std::function<std::size_t(std::size_t)>([map, size, radius](std::size_t iterations) {
+                std::mt19937 generator(2);
+                std::size_t cells = 0;
+                for (std::size_t k = 0; k < iterations; ++k) {
+                    int ci = static_cast<int>(generator() % size);
+                    int cj = static_cast<int>(generator() % size);
+                    long sum = radius_query(*map, ci, cj, radius);
+                    do_not_optimize(sum);
+                    cells += static_cast<std::size_t>((2 * radius + 1) * (2 * radius + 1));
+                }
+                return cells;
+            });
+        }});
+    }
+
+    /**
+     * @brief Прежняя реализация transpose(): построчное чтение, запись с шагом в строку результата
+     */
+    template<typename M>
+    M naive_transpose(const M& m) {
+        M result(m.get_cols(), m.get_rows(), m.get_allocator());
+        for (int i = 0; i < m.get_rows(); ++i) {
+            for (int j = 0; j < m.get_cols(); ++j) {
+                result(j, i) = m(i, j);
+            }
+        }
+        return result;
+    }
+
+    template<typename T>
+    void add_transpose(std::vector<Benchmark>& benchmarks, const std::string& name, int size,
+                       std::function<void(Matrix<T, AlignedAllocator<T>, UncheckedBounds>&)> transpose) {
+        benchmarks.push_back({name + "/" + std::to_string(size), [size, transpose]() {
+            using M = Matrix<T, AlignedAllocator<T>, UncheckedBounds>;
+            auto m = std::make_shared<M>(size, size);
+            std::mt19937 generator(1);
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    (*m)(i, j) = static_cast<T>(generator());
+                }
+            }
+
+            return std::function<std::size_t(std::size_t)>([m, transpose](std::size_t iterations) {
+                for (std::size_t k = 0; k < iterations; ++k) {
+                    transpose(*m);
+                    do_not_optimize((*m)(0, 0));
+                }
+                return iterations * m->size();
+            });
+        }});
+    }
+
+    template<typename T>
+    void add_transposes(std::vector<Benchmark>& benchmarks, const std::string& type, int size) {
+        using M = Matrix<T, AlignedAllocator<T>, UncheckedBounds>;
+        add_transpose<T>(benchmarks, "transpose_" + type + "_naive", size, [](M& m) {
+            M t = naive_transpose(m);
+            do_not_optimize(t(0, 0));
+        });
+        add_transpose<T>(benchmarks, "transpose_" + type + "_blocked", size, [](M& m) {
+            M t = m.transpose();
+            do_not_optimize(t(0, 0));
+        });
+        add_transpose<T>(benchmarks, "transpose_" + type + "_parallel", size, [](M& m) {
+            M t = m.transpose_parallel();
+            do_not_optimize(t(0, 0));
+        });
+        add_transpose<T>(benchmarks, "transpose_" + type + "_in_place", size, [](M& m) { m.transpose_in_place(); });
+        add_transpose<T>(benchmarks, "transpose_" + type + "_in_place_parallel", size,
+                         [](M& m) { m.transpose_in_place_parallel(); });
+    }
+
+    std::vector<Benchmark> benchmarks(int max_size) {
+        std::vector<Benchmark> result;
+        for (int size : {256, 1024, 4096}) {
+            if (size > max_size) {
+                continue;
+            }
+            for (int radius : {4, 16}) {
+                add_radius<int, RowMajor>(result, "radius_int_row_major", size, radius);
+                add_radius<int, Tiled<8>>(result, "radius_int_tiled8", size, radius);
+                add_radius<int, Tiled<16>>(result, "radius_int_tiled16", size, radius);
+                add_radius<int, Morton>(result, "radius_int_morton", size, radius);
+                add_radius<BenchCell, RowMajor>(result, "radius_cell_row_major", size, radius);
+                add_radius<BenchCell, Tiled<8>>(result, "radius_cell_tiled8", size, radius);
+                add_radius<BenchCell, Morton>(result, "radius_cell_morton", size, radius);
+            }
+        }
+        for (int size : {1024, 4096, 16384}) {
+            if (size > max_size) {
+                continue;
+            }
+            add_transposes<int>(result, "int", size);
+            add_transposes<double>(result, "double", size);
+        }
+        return result;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    int max_size = 4096;
+    double min_time = 0.5;
+
+    for (int k = 1; k < argc; ++k) {
+        if (std::strncmp(argv[k], "--filter=", 9) == 0) {
+            filter = argv[k] + 9;
+        } else if (std::strncmp(argv[k], "--max_size=", 11) == 0) {
+            max_size = std::atoi(argv[k] + 11);
+        } else if (std::strncmp(argv[k], "--min_time=", 11) == 0) {
+            min_time = std::atof(argv[k] + 11);
+        } else {
+            std::cerr << "usage: matrix_bench [--filter=substring] [--max_size=N] [--min_time=seconds]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "threads: " << std::thread::hardware_concurrency() << "\n";
+    std::cout << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(14) << "Time, ns"
+              << std::setw(12) << "Iterations" << std::setw(14) << "ns/cell" << "\n"
+              << std::string(80, '-') << "\n";
+
+    for (const Benchmark& benchmark : benchmarks(max_size)) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        auto body = benchmark.setup();
+        std::size_t iterations = 1;
+        double elapsed = 0;
+        std::size_t cells = 0;
+        while (true) {
+            auto start = std::chrono::steady_clock::now();
+            cells = body(iterations);
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed >= min_time) {
+                break;
+            }
+            iterations *= 2;
+        }
+
+        std::cout << std::left << std::setw(40) << benchmark.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(14) << elapsed * 1e9 / iterations << std::setw(12)
+                  << iterations << std::setprecision(4) << std::setw(14) << elapsed * 1e9 / cells << "\n";
+    }
+    return 0;
+}
@@ -1,8 +1,16 @@
 #define CATCH_CONFIG_MAIN
+// Тесты исключений operator[][] не зависят от NDEBUG
+#define MATRIX_BOUNDS_CHECK 1
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include "../Map/matrix.hpp"
 #include <numeric>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 #include <vector>
 #include <algorithm>
@@ -949,3 +957,474 @@ TEST_CASE("Matrix: Iteration over game map", "[game]") {
 }
 
 
+
+namespace {
+    struct CountedCell {
+        static inline int constructed = 0;
+        static inline int alive = 0;
+        static inline int throw_after = -1;
+
+        int value = 0;
+
+        CountedCell() { count(); }
+        CountedCell(const CountedCell& other) : value(other.value) { count(); }
+        CountedCell& operator=(const CountedCell&) = default;
+        ~CountedCell() { --alive; }
+
+        static void reset() {
+            constructed = 0;
+            alive = 0;
+            throw_after = -1;
+        }
+
+    private:
+        void count() {
+            if (throw_after >= 0 && constructed == throw_after) {
+                throw std::runtime_error("CountedCell: construction failed");
+            }
+            ++constructed;
+            ++alive;
+        }
+    };
+}
+
+TEST_CASE("Matrix: storage is aligned to cache line", "[allocator]") {
+    Matrix<char> m(3, 5);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(m.data()) % matrix_alignment == 0);
+
+    Matrix<double> copy(Matrix<double>(7, 9, 1.5));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(copy.data()) % matrix_alignment == 0);
+}
+
+TEST_CASE("Matrix: each element is constructed once", "[allocator]") {
+    CountedCell::reset();
+    {
+        Matrix<CountedCell> m(64, 64);
+        REQUIRE(CountedCell::constructed == 64 * 64);
+
+        CountedCell::constructed = 0;
+        m.resize(32, 96);
+        REQUIRE(CountedCell::constructed == 32 * 96);
+        REQUIRE(CountedCell::alive == 32 * 96);
+    }
+    REQUIRE(CountedCell::alive == 0);
+}
+
+TEST_CASE("Matrix: constructor failure destroys constructed elements", "[allocator][exception]") {
+    CountedCell::reset();
+    CountedCell::throw_after = 10;
+    REQUIRE_THROWS_AS(Matrix<CountedCell>(4, 4), std::runtime_error);
+    REQUIRE(CountedCell::alive == 0);
+
+    CountedCell::reset();
+    Matrix<CountedCell> m(2, 2);
+    CountedCell::throw_after = CountedCell::constructed + 3;
+    REQUIRE_THROWS_AS(m.resize(3, 3), std::runtime_error);
+    REQUIRE(m.get_rows() == 2);
+    REQUIRE(CountedCell::alive == 4);
+}
+
+TEST_CASE("Matrix: pmr allocator", "[allocator]") {
+    alignas(64) static std::byte buffer[1 << 14];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    PmrMatrix<int> m(10, 10, 3, &arena);
+    REQUIRE(m.get_allocator().resource() == &arena);
+    REQUIRE(reinterpret_cast<std::byte*>(m.data()) >= buffer);
+    REQUIRE(reinterpret_cast<std::byte*>(m.data()) < buffer + sizeof(buffer));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(m.data()) % matrix_alignment == 0);
+    REQUIRE(m[9][9] == 3);
+
+    // Копия получает ресурс по умолчанию, как контейнеры std::pmr
+    PmrMatrix<int> copy(m);
+    REQUIRE(copy.get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(copy == m);
+
+    // Перемещение между разными ресурсами копирует элементы в ресурс получателя
+    PmrMatrix<int> target(2, 2, 0, &arena);
+    target = std::move(copy);
+    REQUIRE(target.get_allocator().resource() == &arena);
+    REQUIRE(target == m);
+
+    PmrMatrix<std::pmr::string> names(2, 2, &arena);
+    names[1][1] = "wall";
+    REQUIRE(names[1][1].get_allocator().resource() == &arena);
+}
+
+TEST_CASE("Matrix: operator() - unchecked access", "[access]") {
+    Matrix<int> m(3, 4, 0);
+    m(2, 3) = 7;
+    m(0, 1) = 5;
+
+    REQUIRE(m[2][3] == 7);
+    REQUIRE(std::as_const(m)(0, 1) == 5);
+    static_assert(noexcept(m(0, 0)));
+}
+
+TEST_CASE("Matrix: at() - checked access", "[access][exception]") {
+    Matrix<int, AlignedAllocator<int>, UncheckedBounds> m(2, 2, 1);
+    m.at(1, 1) = 4;
+
+    REQUIRE(m.at(1, 1) == 4);
+    REQUIRE_THROWS_AS(m.at(2, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(std::as_const(m).at(0, -1), std::out_of_range);
+}
+
+TEST_CASE("Matrix: row_span()", "[access]") {
+    Matrix<int> m(3, 5, 0);
+    std::span<int> row = m.row_span(1);
+    REQUIRE(row.size() == 5);
+    std::iota(row.begin(), row.end(), 10);
+
+    REQUIRE(m[1][0] == 10);
+    REQUIRE(m[1][4] == 14);
+    REQUIRE(std::as_const(m).row_span(1)[2] == 12);
+    REQUIRE_THROWS_AS(m.row_span(3), std::out_of_range);
+}
+
+TEST_CASE("Matrix: unchecked bounds policy", "[access]") {
+    static_assert(std::is_same_v<DefaultBoundsCheck, CheckedBounds>);
+
+    Matrix<int, AlignedAllocator<int>, UncheckedBounds> m(4, 4, 0);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            m[i][j] = i * 4 + j;
+        }
+    }
+
+    REQUIRE(m[3][3] == 15);
+    REQUIRE(m.row_span(2).front() == 8);
+    REQUIRE(std::accumulate(m.begin(), m.end(), 0) == 120);
+}
+
+static_assert(std::random_access_iterator<Matrix<int, AlignedAllocator<int>, CheckedBounds, Morton>::iterator>);
+static_assert(std::random_access_iterator<Matrix<int, AlignedAllocator<int>, CheckedBounds, Tiled<4>>::const_iterator>);
+
+template<typename Layout>
+using LayoutMatrix = Matrix<int, AlignedAllocator<int>, CheckedBounds, Layout>;
+
+TEMPLATE_TEST_CASE("Matrix: layout mapping is a bijection", "[layout]", RowMajor, Tiled<4>, Morton) {
+    for (auto [rows, cols] : {std::pair{1, 1}, std::pair{5, 3}, std::pair{3, 17}, std::pair{16, 16}, std::pair{33, 7}}) {
+        typename TestType::mapping mapping(rows, cols);
+        std::vector<bool> used(mapping.required_size(), false);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                std::size_t offset = mapping(i, j);
+                REQUIRE(offset < used.size());
+                REQUIRE_FALSE(used[offset]);
+                used[offset] = true;
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Matrix: layouts keep the matrix API", "[layout]", Tiled<4>, Morton) {
+    Matrix<int> reference(7, 11);
+    LayoutMatrix<TestType> m(7, 11);
+    int counter = 0;
+    for (int i = 0; i < 7; ++i) {
+        for (int j = 0; j < 11; ++j) {
+            reference[i][j] = counter;
+            m[i][j] = counter++;
+        }
+    }
+
+    REQUIRE(m(3, 5) == reference(3, 5));
+    REQUIRE(m.get(6, 10) == 76);
+    REQUIRE_THROWS_AS(m[7][0], std::out_of_range);
+    REQUIRE_THROWS_AS(m[0][11], std::out_of_range);
+
+    // Итераторы обходят ячейки построчно при любой раскладке
+    REQUIRE(std::equal(m.begin(), m.end(), reference.begin(), reference.end()));
+    REQUIRE(m.end() - m.begin() == 77);
+    REQUIRE(*(m.begin() + 12) == 12);
+    REQUIRE(*(m.end() - 1) == 76);
+    REQUIRE(*std::prev(m.cend()) == 76);
+    REQUIRE(std::vector<int>(m.rbegin(), m.rend()) == std::vector<int>(reference.rbegin(), reference.rend()));
+
+    std::sort(m.begin(), m.end(), std::greater<int>());
+    REQUIRE(m[0][0] == 76);
+    REQUIRE(m[6][10] == 0);
+
+    LayoutMatrix<TestType> copy(m);
+    REQUIRE(copy == m);
+    LayoutMatrix<TestType> moved(std::move(copy));
+    REQUIRE(moved == m);
+
+    LayoutMatrix<TestType> transposed = m.transpose();
+    REQUIRE(transposed.get_rows() == 11);
+    REQUIRE(transposed[10][6] == m[6][10]);
+
+    m.resize(9, 5, -1);
+    REQUIRE(m[6][4] == 76 - (6 * 11 + 4));
+    REQUIRE(m[8][4] == -1);
+    REQUIRE(m[2][4] != -1);
+    REQUIRE(std::count(m.begin(), m.end(), -1) == 2 * 5);
+
+    m.fill(3);
+    REQUIRE(std::accumulate(m.begin(), m.end(), 0) == 3 * 45);
+}
+
+TEST_CASE("Matrix: empty matrix with layout", "[layout]") {
+    LayoutMatrix<Morton> m;
+    REQUIRE(m.begin() == m.end());
+    REQUIRE(m.data() == nullptr);
+
+    LayoutMatrix<Tiled<8>> rows_only(4, 0);
+    REQUIRE(rows_only.empty());
+    REQUIRE(rows_only.begin() == rows_only.end());
+}
+
+TEST_CASE("Matrix: shrinking keeps capacity and cells in place", "[resize][capacity]") {
+    Matrix<int> m(4, 6);
+    std::iota(m.begin(), m.end(), 0);
+    int* storage = m.data();
+
+    m.resize(2, 3);
+    REQUIRE(m.data() == storage);
+    REQUIRE(m.get_row_capacity() == 4);
+    REQUIRE(m.get_col_capacity() == 6);
+    REQUIRE(m.get_stride() == 6);
+    REQUIRE(m[1][2] == 8);
+    REQUIRE(std::accumulate(m.begin(), m.end(), 0) == 0 + 1 + 2 + 6 + 7 + 8);
+
+    // Строки не плотные: соседняя строка начинается через stride ячеек
+    REQUIRE(&m[1][0] == m.data() + m.get_stride());
+    REQUIRE(m.row_span(1).size() == 3);
+
+    m.resize(0, 0);
+    REQUIRE(m.empty());
+    REQUIRE(m.data() == nullptr);
+    REQUIRE(m.get_row_capacity() == 4);
+}
+
+TEST_CASE("Matrix: row-major iterator skips stride padding", "[iterator][capacity]") {
+    Matrix<int> m(5, 7);
+    std::iota(m.begin(), m.end(), 0);
+    m.resize(4, 3);
+    REQUIRE(m.get_stride() == 7);
+
+    std::vector<int> expected = {0, 1, 2, 7, 8, 9, 14, 15, 16, 21, 22, 23};
+    REQUIRE(std::vector<int>(m.begin(), m.end()) == expected);
+    REQUIRE(std::vector<int>(m.rbegin(), m.rend()) == std::vector<int>(expected.rbegin(), expected.rend()));
+    REQUIRE(m.end() - m.begin() == 12);
+    REQUIRE(*(m.begin() + 4) == 8);
+    REQUIRE(*(m.end() - 3) == 21);
+    REQUIRE((m.begin() + 5) - (m.begin() + 2) == 3);
+    REQUIRE(m.begin() + 12 == m.end());
+    REQUIRE(m.begin() + 3 < m.begin() + 4);
+
+    auto it = m.begin() + 2;
+    ++it;
+    REQUIRE(&*it == &m[1][0]);
+    --it;
+    REQUIRE(&*it == &m[0][2]);
+
+    std::fill(m.begin(), m.end(), -1);
+    REQUIRE(std::count(m.data(), m.data() + m.get_stride() * 3 + 3, -1) == 12);
+}
+
+TEST_CASE("Matrix: growing within capacity constructs only new cells", "[resize][capacity]") {
+    CountedCell::reset();
+    {
+        Matrix<CountedCell> m(8, 8);
+        m[1][1].value = 5;
+        m.resize(2, 2);
+        REQUIRE(CountedCell::alive == 4);
+
+        CountedCell::constructed = 0;
+        CountedCell* storage = m.data();
+        m.resize(3, 5);
+        REQUIRE(m.data() == storage);
+        REQUIRE(CountedCell::constructed == 3 * 5 - 2 * 2);
+        REQUIRE(CountedCell::alive == 3 * 5);
+        REQUIRE(m[1][1].value == 5);
+
+        CountedCell prototype;
+        prototype.value = 9;
+        CountedCell::constructed = 0;
+        m.resize(4, 5, prototype);
+        REQUIRE(CountedCell::constructed == 5);
+        REQUIRE(m[3][4].value == 9);
+        REQUIRE(m[2][4].value == 0);
+    }
+    REQUIRE(CountedCell::alive == 0);
+}
+
+TEST_CASE("Matrix: growing step by step is amortized", "[resize][capacity]") {
+    Matrix<int> m;
+    int reallocations = 0;
+    for (int n = 1; n <= 1000; ++n) {
+        int* before = m.data();
+        m.resize(n, n, n);
+        if (m.data() != before) {
+            ++reallocations;
+        }
+        REQUIRE(m[n - 1][n - 1] == n);
+        REQUIRE(m[0][0] == 1);
+    }
+    REQUIRE(reallocations <= 11);
+    REQUIRE(m[500][999] == 1000);
+    REQUIRE(m[999][500] == 1000);
+    REQUIRE(m[499][499] == 500);
+}
+
+TEST_CASE("Matrix: failed growth within capacity leaves matrix unchanged", "[resize][capacity][exception]") {
+    CountedCell::reset();
+    Matrix<CountedCell> m(4, 4);
+    m.resize(2, 2);
+    CountedCell::throw_after = CountedCell::constructed + 5;
+    REQUIRE_THROWS_AS(m.resize(3, 4), std::runtime_error);
+    REQUIRE(m.get_rows() == 2);
+    REQUIRE(m.get_cols() == 2);
+    REQUIRE(CountedCell::alive == 4);
+}
+
+TEST_CASE("Matrix: reserve() and shrink_to_fit()", "[resize][capacity]") {
+    Matrix<int> m(2, 3, 7);
+    m.reserve(10, 20);
+    REQUIRE(m.get_rows() == 2);
+    REQUIRE(m.get_cols() == 3);
+    REQUIRE(m.get_row_capacity() == 10);
+    REQUIRE(m.get_col_capacity() == 20);
+    REQUIRE(std::count(m.begin(), m.end(), 7) == 6);
+
+    int* storage = m.data();
+    m.resize(10, 20, 1);
+    REQUIRE(m.data() == storage);
+    REQUIRE(m[1][2] == 7);
+    REQUIRE(m[1][3] == 1);
+
+    m.reserve(1, 1);
+    REQUIRE(m.get_row_capacity() == 10);
+    REQUIRE_THROWS_AS(m.reserve(-1, 1), std::invalid_argument);
+
+    m.resize(3, 4);
+    m.shrink_to_fit();
+    REQUIRE(m.get_row_capacity() == 3);
+    REQUIRE(m.get_col_capacity() == 4);
+    REQUIRE(m.get_stride() == 4);
+    REQUIRE(m[2][3] == 1);
+    REQUIRE(m[0][0] == 7);
+
+    // Копия не наследует запас ёмкости
+    m.reserve(8, 8);
+    Matrix<int> copy(m);
+    REQUIRE(copy.get_row_capacity() == 3);
+    REQUIRE(copy == m);
+}
+
+TEMPLATE_TEST_CASE("Matrix: resize keeps cells with layout", "[resize][layout]", Tiled<4>, Morton) {
+    LayoutMatrix<TestType> m(5, 6);
+    std::iota(m.begin(), m.end(), 0);
+
+    m.resize(9, 13, -1);
+    REQUIRE(m[4][5] == 29);
+    REQUIRE(m[8][12] == -1);
+    REQUIRE(std::count(m.begin(), m.end(), -1) == 9 * 13 - 30);
+
+    m.resize(3, 2);
+    REQUIRE(m[2][1] == 13);
+    m.resize(4, 4);
+    REQUIRE(m[2][1] == 13);
+    REQUIRE(m[3][3] == 0);
+    REQUIRE(std::accumulate(m.begin(), m.end(), 0) == 0 + 1 + 6 + 7 + 12 + 13);
+}
+
+namespace {
+    template<typename M>
+    bool is_transpose_of(const M& t, const M& m) {
+        if (t.get_rows() != m.get_cols() || t.get_cols() != m.get_rows()) {
+            return false;
+        }
+        for (int i = 0; i < m.get_rows(); ++i) {
+            for (int j = 0; j < m.get_cols(); ++j) {
+                if (t(j, i) != m(i, j)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Matrix: blocked transpose() across tile edges", "[utility][transpose]") {
+    // Размеры не кратны плитке, чтобы захватить неполные плитки по краям
+    for (auto [rows, cols] : {std::pair{1, 1}, {1, 70}, {70, 1}, {37, 70}, {64, 32}, {100, 33}}) {
+        Matrix<int> m(rows, cols);
+        std::iota(m.begin(), m.end(), 0);
+
+        Matrix<int> t = m.transpose();
+        REQUIRE(is_transpose_of(t, m));
+        REQUIRE(t.transpose() == m);
+    }
+
+    Matrix<int> rows_only(5, 0);
+    Matrix<int> t = rows_only.transpose();
+    REQUIRE(t.get_rows() == 0);
+    REQUIRE(t.get_cols() == 5);
+}
+
+TEST_CASE("Matrix: transpose_parallel()", "[utility][transpose]") {
+    Matrix<int> m(131, 77);
+    std::iota(m.begin(), m.end(), 0);
+
+    for (unsigned threads : {0u, 1u, 3u, 64u}) {
+        Matrix<int> t = m.transpose_parallel(threads);
+        REQUIRE(t == m.transpose());
+    }
+
+    Matrix<int> empty;
+    REQUIRE(empty.transpose_parallel(4).empty());
+}
+
+TEST_CASE("Matrix: transpose_in_place()", "[utility][transpose]") {
+    for (int n : {1, 2, 31, 32, 33, 100}) {
+        Matrix<int> m(n, n);
+        std::iota(m.begin(), m.end(), 0);
+        Matrix<int> expected = m.transpose();
+        int* storage = m.data();
+
+        Matrix<int> sequential(m);
+        sequential.transpose_in_place();
+        REQUIRE(sequential == expected);
+
+        m.transpose_in_place_parallel(3);
+        REQUIRE(m == expected);
+        REQUIRE(m.data() == storage);
+    }
+
+    Matrix<int> rectangular(2, 3);
+    REQUIRE_THROWS_AS(rectangular.transpose_in_place(), std::logic_error);
+    REQUIRE_THROWS_AS(rectangular.transpose_in_place_parallel(), std::logic_error);
+}
+
+TEST_CASE("Matrix: transpose with capacity and non-trivial cells", "[utility][transpose]") {
+    Matrix<std::string> m(3, 4);
+    m.reserve(8, 8);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            m[i][j] = std::to_string(i) + ":" + std::to_string(j);
+        }
+    }
+
+    Matrix<std::string> t = m.transpose_parallel(2);
+    REQUIRE(t[3][2] == "2:3");
+    REQUIRE(is_transpose_of(t, m));
+
+    m.resize(4, 4, "x");
+    m.transpose_in_place();
+    REQUIRE(m[3][1] == "1:3");
+    REQUIRE(m[0][3] == "x");
+}
+
+TEMPLATE_TEST_CASE("Matrix: transpose with layout", "[transpose][layout]", Tiled<4>, Morton) {
+    LayoutMatrix<TestType> m(45, 45);
+    std::iota(m.begin(), m.end(), 0);
+
+    LayoutMatrix<TestType> t = m.transpose_parallel(2);
+    REQUIRE(is_transpose_of(t, m));
+
+    m.transpose_in_place_parallel(2);
+    REQUIRE(m == t);
+}